@@ -18,7 +18,8 @@
 #include "Weapon/WeaponBase.h"
 #include "Save/TwoDSurvivalSaveGame.h"
 #include "Kismet/GameplayStatics.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "Data/DefinitionCatalog.h"
+#include "Engine/GameInstance.h"
 #include "UI/HealthHUDWidget.h"
 #include "UI/HotbarWidget.h"
 #include "UI/CraftingWidget.h"
@@ -168,26 +169,6 @@ void ABaseCharacter::CreateInputActions()
 	GameplayIMC->MapKey(IA_PlaceCancel, EKeys::Escape);
 }
 
-void ABaseCharacter::ScanItemDefinitions()
-{
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAssetsByClass(UItemDefinition::StaticClass()->GetClassPathName(), AssetDataList);
-
-	for (const FAssetData& AssetData : AssetDataList)
-	{
-		UItemDefinition* Def = Cast<UItemDefinition>(AssetData.GetAsset());
-		if (Def && !Def->ItemID.IsNone())
-		{
-			ItemDefMap.Add(Def->ItemID, Def);
-		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("Auto-scanned %d item definitions."), ItemDefMap.Num());
-}
-
 void ABaseCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -280,9 +261,6 @@ void ABaseCharacter::BeginPlay()
 		}
 	}
 
-	// Auto-scan all item definitions via AssetRegistry
-	ScanItemDefinitions();
-
 	// Create dynamic material instances on every mesh slot so we can drive
 	// the CharacterForward parameter for the backside-darkening shader.
 	if (USkeletalMeshComponent* SkelMesh = GetMesh())
@@ -791,8 +769,9 @@ void ABaseCharacter::OnBodyPartDamaged(EBodyPart Part, float CurrentHealth, floa
 
 UItemDefinition* ABaseCharacter::FindItemDefByID(FName ItemID) const
 {
-	UItemDefinition* const* Found = ItemDefMap.Find(ItemID);
-	return Found ? *Found : nullptr;
+	UGameInstance* GI = GetGameInstance();
+	UDefinitionCatalog* Catalog = GI ? GI->GetSubsystem<UDefinitionCatalog>() : nullptr;
+	return Catalog ? Catalog->FindItem(ItemID) : nullptr;
 }
 
 // ── Placement mode ────────────────────────────────────────────────────────────
@@ -93,6 +93,14 @@ void UHealthComponent::SetBodyPartHealth(EBodyPart Part, float NewCurrentHealth)
 	Data->CurrentHealth = FMath::Clamp(NewCurrentHealth, 0.f, Data->MaxHealth);
 }
 
+void UHealthComponent::ResetHealth()
+{
+	for (TPair<EBodyPart, FBodyPartHealth>& Part : BodyParts)
+	{
+		Part.Value.CurrentHealth = Part.Value.MaxHealth;
+	}
+}
+
 float UHealthComponent::GetMovementSpeedMultiplier() const
 {
 	const FBodyPartHealth* Left  = BodyParts.Find(EBodyPart::LeftLeg);
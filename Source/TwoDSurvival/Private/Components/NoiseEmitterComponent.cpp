@@ -1,8 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Components/NoiseEmitterComponent.h"
-#include "Enemy/EnemyBase.h"
-#include "EngineUtils.h"
+#include "Enemy/EnemyAIManager.h"
+#include "Engine/World.h"
 
 UNoiseEmitterComponent::UNoiseEmitterComponent()
 {
@@ -32,17 +32,9 @@ void UNoiseEmitterComponent::EmitNoise(ENoiseType Type, float RadiusOverride)
 
 void UNoiseEmitterComponent::BroadcastNoiseAt(UWorld* World, FVector Origin, float Radius)
 {
-	if (!World) return;
-
-	for (TActorIterator<AEnemyBase> It(World); It; ++It)
+	if (UEnemyAIManager* AI = World ? World->GetSubsystem<UEnemyAIManager>() : nullptr)
 	{
-		AEnemyBase* Enemy = *It;
-		if (!Enemy) continue;
-
-		if (FVector::Dist(Origin, Enemy->GetActorLocation()) <= Radius)
-		{
-			Enemy->HearNoise(Origin);
-		}
+		AI->ReportNoise(Origin, Radius);
 	}
 }
 
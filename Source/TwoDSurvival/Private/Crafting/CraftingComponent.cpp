@@ -4,7 +4,9 @@
 #include "Crafting/CraftingRecipe.h"
 #include "Inventory/InventoryComponent.h"
 #include "Inventory/ItemDefinition.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "Data/DefinitionCatalog.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 #include "Character/BaseCharacter.h"
 #include "Components/SkillComponent.h"
 
@@ -16,42 +18,33 @@ UCraftingComponent::UCraftingComponent()
 void UCraftingComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	ScanAssets();
+	CacheRecipes();
 }
 
-void UCraftingComponent::ScanAssets()
+UDefinitionCatalog* UCraftingComponent::GetCatalog() const
 {
-	FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AR = ARM.Get();
+	const UWorld* World = GetWorld();
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UDefinitionCatalog>() : nullptr;
+}
 
-	// Build ItemID → ItemDefinition map
-	TArray<FAssetData> ItemAssets;
-	AR.GetAssetsByClass(UItemDefinition::StaticClass()->GetClassPathName(), ItemAssets);
-	for (const FAssetData& AD : ItemAssets)
-	{
-		UItemDefinition* Def = Cast<UItemDefinition>(AD.GetAsset());
-		if (Def && !Def->ItemID.IsNone())
-			ItemDefMap.Add(Def->ItemID, Def);
-	}
+void UCraftingComponent::CacheRecipes()
+{
+	UDefinitionCatalog* Catalog = GetCatalog();
+	if (!Catalog) return;
 
-	// Collect all crafting recipes
-	TArray<FAssetData> RecipeAssets;
-	AR.GetAssetsByClass(UCraftingRecipe::StaticClass()->GetClassPathName(), RecipeAssets);
-	for (const FAssetData& AD : RecipeAssets)
-	{
-		UCraftingRecipe* Recipe = Cast<UCraftingRecipe>(AD.GetAsset());
-		if (Recipe && !Recipe->RecipeID.IsNone())
-			AllRecipes.Add(Recipe);
-	}
+	// Recipe list is shared by every crafting component — copy the pointers in catalog (RecipeID) order.
+	AllRecipes.Reset();
+	for (UCraftingRecipe* Recipe : Catalog->GetRecipes())
+		AllRecipes.Add(Recipe);
 
-	UE_LOG(LogTemp, Log, TEXT("CraftingComponent: %d recipes, %d item defs scanned."),
-		AllRecipes.Num(), ItemDefMap.Num());
+	UE_LOG(LogTemp, Log, TEXT("CraftingComponent: %d recipes available."), AllRecipes.Num());
 }
 
 UItemDefinition* UCraftingComponent::FindItemDef(FName ItemID) const
 {
-	UItemDefinition* const* Found = ItemDefMap.Find(ItemID);
-	return Found ? *Found : nullptr;
+	UDefinitionCatalog* Catalog = GetCatalog();
+	return Catalog ? Catalog->FindItem(ItemID) : nullptr;
 }
 
 void UCraftingComponent::LearnRecipe(FName RecipeID)
@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/DefinitionCatalog.h"
+#include "Inventory/ItemDefinition.h"
+#include "Crafting/CraftingRecipe.h"
+#include "World/StreetDefinition.h"
+#include "World/CityDefinition.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Algo/Sort.h"
+
+namespace
+{
+	void GatherPaths(IAssetRegistry& AR, UClass* Class, TArray<FSoftObjectPath>& OutPaths)
+	{
+		TArray<FAssetData> Assets;
+		AR.GetAssetsByClass(Class->GetClassPathName(), Assets);
+
+		OutPaths.Reset(Assets.Num());
+		for (const FAssetData& AD : Assets)
+			OutPaths.Add(AD.GetSoftObjectPath());
+	}
+
+	/**
+	 * Resolves the loaded assets, drops ones without an ID (or duplicate IDs), sorts by ID
+	 * and fills the ID → index map. IDOf returns the definition's stable FName key.
+	 */
+	template <typename TDef, typename FIDOf>
+	void BuildTable(const TArray<FSoftObjectPath>& Paths, FIDOf IDOf,
+		TArray<TObjectPtr<TDef>>& OutDefs, TMap<FName, int32>& OutIndexByID)
+	{
+		OutDefs.Reset(Paths.Num());
+		OutIndexByID.Reset();
+
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			// ResolveObject hits for anything the streamable load brought in; TryLoad only
+			// fires for an asset that failed async (and will log the same error again).
+			UObject* Obj = Path.ResolveObject();
+			if (!Obj) Obj = Path.TryLoad();
+
+			TDef* Def = Cast<TDef>(Obj);
+			if (Def && !IDOf(Def).IsNone())
+				OutDefs.Add(Def);
+		}
+
+		// Stable sort on the ID string so the dense index doesn't depend on registry order.
+		Algo::StableSort(OutDefs, [&IDOf](const TObjectPtr<TDef>& A, const TObjectPtr<TDef>& B)
+		{
+			return IDOf(A.Get()).LexicalLess(IDOf(B.Get()));
+		});
+
+		OutIndexByID.Reserve(OutDefs.Num());
+		for (int32 i = 0; i < OutDefs.Num(); )
+		{
+			const FName ID = IDOf(OutDefs[i].Get());
+			if (OutIndexByID.Contains(ID))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[DefinitionCatalog] Duplicate ID '%s' (%s) — keeping the first."),
+					*ID.ToString(), *OutDefs[i]->GetPathName());
+				OutDefs.RemoveAt(i);
+				continue;
+			}
+			OutIndexByID.Add(ID, i);
+			++i;
+		}
+	}
+
+	int32 IndexOf(const TMap<FName, int32>& IndexByID, FName ID)
+	{
+		const int32* Found = IndexByID.Find(ID);
+		return Found ? *Found : INDEX_NONE;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lifecycle
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UDefinitionCatalog::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AR.IsLoadingAssets())
+	{
+		// Editor startup: the registry is still discovering files — wait for it rather than blocking.
+		FilesLoadedHandle = AR.OnFilesLoaded().AddUObject(this, &UDefinitionCatalog::StartLoad);
+		return;
+	}
+
+	StartLoad();
+}
+
+void UDefinitionCatalog::Deinitialize()
+{
+	if (FilesLoadedHandle.IsValid())
+	{
+		if (FAssetRegistryModule* ARM = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+			ARM->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+		FilesLoadedHandle.Reset();
+	}
+
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->CancelHandle();
+		LoadHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UDefinitionCatalog::EnsureReady()
+{
+	if (bReady) return;
+
+	if (!bLoadStarted)
+	{
+		IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (AR.IsLoadingAssets())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[DefinitionCatalog] Lookup before the AssetRegistry finished scanning — blocking."));
+			AR.WaitForCompletion();
+		}
+		StartLoad();
+	}
+
+	if (!bReady && LoadHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[DefinitionCatalog] Lookup before async load finished — waiting."));
+		LoadHandle->WaitUntilComplete();
+	}
+
+	// WaitUntilComplete normally fires the completion delegate; build here if it didn't.
+	if (!bReady)
+		BuildTables();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Build
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UDefinitionCatalog::StartLoad()
+{
+	if (bLoadStarted) return;
+	bLoadStarted = true;
+
+	IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (FilesLoadedHandle.IsValid())
+	{
+		AR.OnFilesLoaded().Remove(FilesLoadedHandle);
+		FilesLoadedHandle.Reset();
+	}
+
+	GatherPaths(AR, UItemDefinition::StaticClass(),   ItemPaths);
+	GatherPaths(AR, UCraftingRecipe::StaticClass(),   RecipePaths);
+	GatherPaths(AR, UStreetDefinition::StaticClass(), StreetPaths);
+	GatherPaths(AR, UCityDefinition::StaticClass(),   CityPaths);
+
+	TArray<FSoftObjectPath> AllPaths;
+	AllPaths.Reserve(ItemPaths.Num() + RecipePaths.Num() + StreetPaths.Num() + CityPaths.Num());
+	AllPaths.Append(ItemPaths);
+	AllPaths.Append(RecipePaths);
+	AllPaths.Append(StreetPaths);
+	AllPaths.Append(CityPaths);
+
+	if (AllPaths.IsEmpty())
+	{
+		BuildTables();
+		return;
+	}
+
+	LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AllPaths),
+		FStreamableDelegate::CreateUObject(this, &UDefinitionCatalog::BuildTables));
+
+	// RequestAsyncLoad returns null when everything is already in memory (and has already
+	// called the delegate in that case).
+	if (!LoadHandle.IsValid() && !bReady)
+		BuildTables();
+	else if (bReady)
+		LoadHandle.Reset();
+}
+
+void UDefinitionCatalog::BuildTables()
+{
+	if (bReady) return;
+
+	BuildTable<UItemDefinition>(ItemPaths,
+		[](const UItemDefinition* D) { return D->ItemID; }, Items, ItemIndexByID);
+	BuildTable<UCraftingRecipe>(RecipePaths,
+		[](const UCraftingRecipe* D) { return D->RecipeID; }, Recipes, RecipeIndexByID);
+	BuildTable<UStreetDefinition>(StreetPaths,
+		[](const UStreetDefinition* D) { return D->StreetID; }, Streets, StreetIndexByID);
+	BuildTable<UCityDefinition>(CityPaths,
+		[](const UCityDefinition* D) { return D->CityID; }, Cities, CityIndexByID);
+
+	// Tables hold strong references now — the streamable handle is no longer needed.
+	LoadHandle.Reset();
+	ItemPaths.Empty();
+	RecipePaths.Empty();
+	StreetPaths.Empty();
+	CityPaths.Empty();
+
+	bReady = true;
+
+	UE_LOG(LogTemp, Log, TEXT("[DefinitionCatalog] Indexed %d items, %d recipes, %d streets, %d cities."),
+		Items.Num(), Recipes.Num(), Streets.Num(), Cities.Num());
+
+	OnCatalogReady.Broadcast();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Lookups
+// ─────────────────────────────────────────────────────────────────────────────
+
+UItemDefinition* UDefinitionCatalog::FindItem(FName ItemID)
+{
+	return GetItemByIndex(GetItemIndex(ItemID));
+}
+
+int32 UDefinitionCatalog::GetItemIndex(FName ItemID)
+{
+	EnsureReady();
+	return IndexOf(ItemIndexByID, ItemID);
+}
+
+UCraftingRecipe* UDefinitionCatalog::FindRecipe(FName RecipeID)
+{
+	return GetRecipeByIndex(GetRecipeIndex(RecipeID));
+}
+
+int32 UDefinitionCatalog::GetRecipeIndex(FName RecipeID)
+{
+	EnsureReady();
+	return IndexOf(RecipeIndexByID, RecipeID);
+}
+
+UStreetDefinition* UDefinitionCatalog::FindStreet(FName StreetID)
+{
+	return GetStreetByIndex(GetStreetIndex(StreetID));
+}
+
+int32 UDefinitionCatalog::GetStreetIndex(FName StreetID)
+{
+	EnsureReady();
+	return IndexOf(StreetIndexByID, StreetID);
+}
+
+UCityDefinition* UDefinitionCatalog::FindCity(FName CityID)
+{
+	return GetCityByIndex(GetCityIndex(CityID));
+}
+
+int32 UDefinitionCatalog::GetCityIndex(FName CityID)
+{
+	EnsureReady();
+	return IndexOf(CityIndexByID, CityID);
+}
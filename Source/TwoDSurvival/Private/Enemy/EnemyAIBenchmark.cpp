@@ -0,0 +1,472 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyAIManager.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyMoverComponent.h"
+#include "Character/BaseCharacter.h"
+#include "Character/HealthComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Benchmark
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace
+{
+	/**
+	 * Each enemy count is measured three times. Movement and overlap cost are the actor tick time
+	 * that disappears when the enemies' movement components, or their overlap events, are switched off.
+	 */
+	enum class EBenchSegment : uint8
+	{
+		Full,
+		NoOverlaps,
+		NoMovement,
+		Num
+	};
+
+	const TCHAR* const SegmentNames[] = { TEXT("full"), TEXT("no_overlaps"), TEXT("no_movement") };
+
+	struct FBenchSegmentSamples
+	{
+		TArray<double> FrameMs;			// Scripted player + the whole world tick.
+		TArray<double> ActorTickMs;		// Tick groups — movement, overlaps, animation.
+		TArray<double> ReportNoiseMs;	// The scripted player's ReportNoise calls.
+		FEnemyAIPhaseTimings AISum;
+
+		static double Average(const TArray<double>& Samples)
+		{
+			double Sum = 0.0;
+			for (double S : Samples) Sum += S;
+			return Samples.Num() > 0 ? Sum / Samples.Num() : 0.0;
+		}
+
+		static double Percentile(TArray<double> Samples, double P)
+		{
+			if (Samples.Num() == 0) return 0.0;
+			Samples.Sort();
+			return Samples[FMath::Clamp(FMath::CeilToInt(P * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+		}
+
+		double AverageAI(double FEnemyAIPhaseTimings::* Phase) const
+		{
+			return FrameMs.Num() > 0 ? AISum.*Phase / FrameMs.Num() : 0.0;
+		}
+
+		double AverageAITotal() const
+		{
+			return FrameMs.Num() > 0 ? AISum.TotalMs() / FrameMs.Num() : 0.0;
+		}
+	};
+
+	struct FBenchCountResult
+	{
+		int32 Count = 0;
+		FBenchSegmentSamples Segments[(int32)EBenchSegment::Num];
+	};
+
+	/**
+	 * One enemy count of TwoDSurvival.Enemy.ScaleBenchmark: spawns the enemies on a synthetic street,
+	 * scripts the player stand-in and steps the world at a fixed delta, sampling every frame.
+	 */
+	class FEnemyAIBenchmark
+	{
+	public:
+		FEnemyAIBenchmark(UWorld* InWorld, ABaseCharacter* InPlayer, TSubclassOf<AEnemyBase> InClass,
+			int32 InFrames, int32 InWarmUpFrames)
+			: World(InWorld), Player(InPlayer), EnemyClass(InClass), Frames(InFrames), WarmUpFrames(InWarmUpFrames)
+		{
+			Origin = FVector(0.f, InPlayer->GetActorLocation().Y, 0.f);
+
+			PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddRaw(this, &FEnemyAIBenchmark::OnPreActorTick);
+			PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FEnemyAIBenchmark::OnPostActorTick);
+		}
+
+		~FEnemyAIBenchmark()
+		{
+			FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+			FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+		}
+
+		// Simulation step — fixed so runs are comparable whatever the machine.
+		static constexpr float FixedDelta = 1.f / 30.f;
+
+		// Spawns Count enemies and measures the three segments, WarmUpFrames + Frames each.
+		FBenchCountResult Run(int32 Count)
+		{
+			SpawnCount(Count);
+
+			FBenchCountResult Result;
+			Result.Count = Spawned.Num();
+
+			for (int32 s = 0; s < (int32)EBenchSegment::Num; ++s)
+			{
+				BeginSegment((EBenchSegment)s);
+				for (int32 f = 0; f < WarmUpFrames; ++f)
+				{
+					Step();
+				}
+				for (int32 f = 0; f < Frames; ++f)
+				{
+					Step();
+					Record(Result.Segments[s]);
+				}
+			}
+			return Result;
+		}
+
+		static FString Summarize(const FBenchCountResult& R)
+		{
+			const FBenchSegmentSamples& Full = R.Segments[(int32)EBenchSegment::Full];
+			return FString::Printf(
+				TEXT("%5d enemies — frame avg %.2f ms p95 %.2f ms | AI %.2f ms | movement %.2f ms | overlaps %.2f ms"),
+				R.Count, FBenchSegmentSamples::Average(Full.FrameMs), FBenchSegmentSamples::Percentile(Full.FrameMs, 0.95),
+				Full.AverageAITotal(), MovementMs(R), OverlapMs(R));
+		}
+
+		FString BuildReport(const FBenchCountResult& R) const
+		{
+			const FBenchSegmentSamples& Full = R.Segments[(int32)EBenchSegment::Full];
+
+			const double Gather = Full.AverageAI(&FEnemyAIPhaseTimings::GatherMs);
+			const double Noise = Full.AverageAI(&FEnemyAIPhaseTimings::NoiseMs);
+			const double Significance = Full.AverageAI(&FEnemyAIPhaseTimings::SignificanceMs);
+			const double Crowd = Full.AverageAI(&FEnemyAIPhaseTimings::CrowdMs);
+			const double Decide = Full.AverageAI(&FEnemyAIPhaseTimings::DecideMs);
+			const double WriteBack = Full.AverageAI(&FEnemyAIPhaseTimings::WriteBackMs);
+
+			FString Json;
+			Json += TEXT("{\n");
+			Json += TEXT("  \"benchmark\": \"EnemyAI\",\n");
+			Json += FString::Printf(TEXT("  \"timestamp\": \"%s\",\n"), *FDateTime::UtcNow().ToIso8601());
+			Json += FString::Printf(TEXT("  \"enemy_class\": \"%s\",\n"), *EnemyClass->GetPathName());
+			Json += FString::Printf(TEXT("  \"frames_per_segment\": %d,\n"), Frames);
+			Json += FString::Printf(TEXT("  \"warmup_frames\": %d,\n"), WarmUpFrames);
+			Json += FString::Printf(TEXT("  \"fixed_delta_ms\": %.3f,\n"), FixedDelta * 1000.0);
+			Json += TEXT("  \"results\": [\n");
+			Json += TEXT("    {\n");
+			Json += FString::Printf(TEXT("      \"enemies\": %d,\n"), R.Count);
+			Json += FString::Printf(TEXT("      \"frame_ms\": { \"avg\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"max\": %.4f },\n"),
+				FBenchSegmentSamples::Average(Full.FrameMs), FBenchSegmentSamples::Percentile(Full.FrameMs, 0.5),
+				FBenchSegmentSamples::Percentile(Full.FrameMs, 0.95), FBenchSegmentSamples::Percentile(Full.FrameMs, 1.0));
+			Json += FString::Printf(TEXT("      \"ai_tick_ms\": { \"total\": %.4f, \"gather\": %.4f, \"noise\": %.4f, \"significance\": %.4f, \"crowd\": %.4f, \"decide\": %.4f, \"write_back\": %.4f },\n"),
+				Gather + Noise + Significance + Crowd + Decide + WriteBack, Gather, Noise, Significance, Crowd, Decide, WriteBack);
+			Json += FString::Printf(TEXT("      \"noise_ms\": %.4f,\n"), Noise + FBenchSegmentSamples::Average(Full.ReportNoiseMs));
+			Json += FString::Printf(TEXT("      \"actor_tick_ms\": %.4f,\n"), FBenchSegmentSamples::Average(Full.ActorTickMs));
+			Json += FString::Printf(TEXT("      \"movement_ms\": %.4f,\n"), MovementMs(R));
+			Json += FString::Printf(TEXT("      \"overlap_ms\": %.4f,\n"), OverlapMs(R));
+			Json += TEXT("      \"segments\": {");
+
+			for (int32 s = 0; s < (int32)EBenchSegment::Num; ++s)
+			{
+				const FBenchSegmentSamples& S = R.Segments[s];
+				Json += FString::Printf(TEXT("%s\n        \"%s\": { \"frame_ms\": %.4f, \"actor_tick_ms\": %.4f }"),
+					s > 0 ? TEXT(",") : TEXT(""), SegmentNames[s],
+					FBenchSegmentSamples::Average(S.FrameMs), FBenchSegmentSamples::Average(S.ActorTickMs));
+			}
+
+			Json += TEXT("\n      }\n");
+			Json += TEXT("    }\n");
+			Json += TEXT("  ]\n}\n");
+			return Json;
+		}
+
+	private:
+		// Enemies are spaced this far apart along X, so crowd density is the same at every count.
+		static constexpr float EnemySpacing = 60.f;
+		static constexpr float MinStreetLength = 4000.f;
+
+		// The player walks ±40% of the street and back every PlayerPeriod seconds, making a noise
+		// every NoiseInterval.
+		static constexpr float PlayerPeriod = 20.f;
+		static constexpr float NoiseInterval = 0.5f;
+		static constexpr float NoiseRadius = 1500.f;
+
+		UWorld* World;
+		ABaseCharacter* Player;
+		TSubclassOf<AEnemyBase> EnemyClass;
+		int32 Frames;
+		int32 WarmUpFrames;
+
+		FVector Origin;
+		float StreetLength = 0.f;
+
+		TArray<TWeakObjectPtr<AEnemyBase>> Spawned;
+
+		// Components that generated overlap events when spawned — toggled for NoOverlaps.
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> OverlapComponents;
+
+		double ScriptStartTime = 0.0;
+		double NextNoiseTime = 0.0;
+
+		// This frame's timings.
+		double FrameMs = 0.0;
+		double ActorTickStart = 0.0;
+		double ActorTickMs = 0.0;
+		double ReportNoiseMs = 0.0;
+
+		FDelegateHandle PreActorTickHandle;
+		FDelegateHandle PostActorTickHandle;
+
+		void OnPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+		{
+			if (InWorld == World) ActorTickStart = FPlatformTime::Seconds();
+		}
+
+		void OnPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+		{
+			if (InWorld == World) ActorTickMs = (FPlatformTime::Seconds() - ActorTickStart) * 1000.0;
+		}
+
+		// One frame: the scripted player, then the whole world tick — actors, movement and the
+		// AI manager.
+		void Step()
+		{
+			const double Start = FPlatformTime::Seconds();
+			ActorTickMs = 0.0;
+			ReportNoiseMs = 0.0;
+
+			ScriptPlayer();
+			World->Tick(LEVELTICK_All, FixedDelta);
+			++GFrameCounter;
+
+			FrameMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+		}
+
+		// ── Scripted player ───────────────────────────────────────────────────
+
+		void ScriptPlayer()
+		{
+			// The crowd is meant to reach and hit the player — keep them alive for the whole run.
+			if (Player->HealthComponent)
+			{
+				Player->HealthComponent->ResetHealth();
+			}
+
+			const double T = World->GetTimeSeconds() - ScriptStartTime;
+			const float Half = Player->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+			const float X = Origin.X + StreetLength * 0.4f * FMath::Sin(UE_TWO_PI * T / PlayerPeriod);
+			Player->SetActorLocation(FVector(X, Origin.Y, Origin.Z + Half + 2.f), false, nullptr, ETeleportType::TeleportPhysics);
+
+			if (World->GetTimeSeconds() >= NextNoiseTime)
+			{
+				NextNoiseTime = World->GetTimeSeconds() + NoiseInterval;
+				if (UEnemyAIManager* AI = World->GetSubsystem<UEnemyAIManager>())
+				{
+					const double Start = FPlatformTime::Seconds();
+					AI->ReportNoise(Player->GetActorLocation(), NoiseRadius);
+					ReportNoiseMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+				}
+			}
+		}
+
+		// ── Synthetic street ──────────────────────────────────────────────────
+
+		void SpawnCount(int32 Count)
+		{
+			StreetLength = FMath::Max(MinStreetLength, Count * EnemySpacing);
+
+			FActorSpawnParameters FloorParams;
+			FloorParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			if (AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(Origin, FRotator::ZeroRotator, FloorParams))
+			{
+				UStaticMeshComponent* Mesh = Floor->GetStaticMeshComponent();
+				Mesh->SetMobility(EComponentMobility::Movable);
+				Mesh->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+
+				// The engine cube is 100 cm, centred — top face at Origin.Z.
+				Floor->SetActorLocation(Origin - FVector(0.f, 0.f, 50.f));
+				Floor->SetActorScale3D(FVector(StreetLength / 100.f + 20.f, 20.f, 1.f));
+			}
+
+			const AEnemyBase* CDO = EnemyClass->GetDefaultObject<AEnemyBase>();
+			const float Half = CDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+			FActorSpawnParameters Params;
+			Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+			const double Start = FPlatformTime::Seconds();
+			Spawned.Reserve(Count);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const float X = Origin.X - StreetLength * 0.5f + (i + 0.5f) * StreetLength / Count;
+				const FRotator Rotation = (i & 1) ? FRotator(0.f, 180.f, 0.f) : FRotator::ZeroRotator;
+
+				AEnemyBase* Enemy = World->SpawnActor<AEnemyBase>(EnemyClass, FVector(X, Origin.Y, Origin.Z + Half + 2.f), Rotation, Params);
+				if (!Enemy) continue;
+
+				Spawned.Add(Enemy);
+
+				TInlineComponentArray<UPrimitiveComponent*> Primitives(Enemy);
+				for (UPrimitiveComponent* Primitive : Primitives)
+				{
+					if (Primitive->GetGenerateOverlapEvents()) OverlapComponents.Add(Primitive);
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("[EnemyAIBenchmark] %d x %s spawned on a %.0f m street in %.1f ms."),
+				Spawned.Num(), *EnemyClass->GetName(), StreetLength / 100.f, (FPlatformTime::Seconds() - Start) * 1000.0);
+
+			ScriptStartTime = World->GetTimeSeconds();
+			NextNoiseTime = ScriptStartTime;
+		}
+
+		void BeginSegment(EBenchSegment Segment)
+		{
+			const bool bOverlaps = Segment != EBenchSegment::NoOverlaps;
+			for (const TWeakObjectPtr<UPrimitiveComponent>& Primitive : OverlapComponents)
+			{
+				if (Primitive.IsValid()) Primitive->SetGenerateOverlapEvents(bOverlaps);
+			}
+
+			const bool bMovement = Segment != EBenchSegment::NoMovement;
+			for (const TWeakObjectPtr<AEnemyBase>& Enemy : Spawned)
+			{
+				if (!Enemy.IsValid()) continue;
+				Enemy->GetCharacterMovement()->SetComponentTickEnabled(bMovement);
+				Enemy->Mover->SetComponentTickEnabled(bMovement && Enemy->Mover->bUseKinematicMover);
+			}
+		}
+
+		// ── Sampling / report ─────────────────────────────────────────────────
+
+		void Record(FBenchSegmentSamples& S) const
+		{
+			S.FrameMs.Add(FrameMs);
+			S.ActorTickMs.Add(ActorTickMs);
+			S.ReportNoiseMs.Add(ReportNoiseMs);
+
+			if (const UEnemyAIManager* AI = World->GetSubsystem<UEnemyAIManager>())
+			{
+				const FEnemyAIPhaseTimings& T = AI->GetLastPhaseTimings();
+				S.AISum.GatherMs += T.GatherMs;
+				S.AISum.NoiseMs += T.NoiseMs;
+				S.AISum.SignificanceMs += T.SignificanceMs;
+				S.AISum.CrowdMs += T.CrowdMs;
+				S.AISum.DecideMs += T.DecideMs;
+				S.AISum.WriteBackMs += T.WriteBackMs;
+			}
+		}
+
+		static double MovementMs(const FBenchCountResult& R)
+		{
+			return FMath::Max(0.0, FBenchSegmentSamples::Average(R.Segments[(int32)EBenchSegment::Full].ActorTickMs)
+				- FBenchSegmentSamples::Average(R.Segments[(int32)EBenchSegment::NoMovement].ActorTickMs));
+		}
+
+		static double OverlapMs(const FBenchCountResult& R)
+		{
+			return FMath::Max(0.0, FBenchSegmentSamples::Average(R.Segments[(int32)EBenchSegment::Full].ActorTickMs)
+				- FBenchSegmentSamples::Average(R.Segments[(int32)EBenchSegment::NoOverlaps].ActorTickMs));
+		}
+	};
+}
+
+/**
+ * Enemy AI cost at 50 / 200 / 1000 / 5000 enemies, one test per count, each in its own transient
+ * world. The enemies stand on a synthetic street with a player stand-in that walks it back and
+ * forth and makes a noise every half second. Each count runs three measured segments (full,
+ * overlap events off, enemy movement off) of Frames frames after WarmUpFrames each. The test
+ * writes Saved/Benchmarks/EnemyAI_<count>_<time>.json with game-thread frame ms (avg/p50/p95/max),
+ * AI update ms per phase, noise ms, actor tick ms, and the movement and overlap cost taken from
+ * the segment differences.
+ *
+ * Headless, on a machine without a GPU:
+ *   UnrealEditor-Cmd TwoDSurvival.uproject -nullrhi -unattended -nosound
+ *     -ExecCmds="Automation RunTests TwoDSurvival.Enemy.ScaleBenchmark" -TestExit="Automation Test Queue Empty"
+ * Optional: -EnemyAIBenchFrames=300 -EnemyAIBenchWarmUp=60 -EnemyAIBenchClass=<Blueprint enemy class
+ * path>, the last to include its mesh, AnimBP and mover settings.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FEnemyAIScaleBenchmark, "TwoDSurvival.Enemy.ScaleBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FEnemyAIScaleBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 Count : { 50, 200, 1000, 5000 })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%d"), Count));
+		OutTestCommands.Add(FString::FromInt(Count));
+	}
+}
+
+bool FEnemyAIScaleBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Count = FCString::Atoi(*Parameters);
+	if (!TestTrue(TEXT("Enemy count"), Count > 0)) return false;
+
+	int32 Frames = 300;
+	int32 WarmUpFrames = 60;
+	FParse::Value(FCommandLine::Get(), TEXT("EnemyAIBenchFrames="), Frames);
+	FParse::Value(FCommandLine::Get(), TEXT("EnemyAIBenchWarmUp="), WarmUpFrames);
+	Frames = FMath::Max(1, Frames);
+	WarmUpFrames = FMath::Max(1, WarmUpFrames);
+
+	TSubclassOf<AEnemyBase> EnemyClass = AEnemyBase::StaticClass();
+	FString ClassPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("EnemyAIBenchClass="), ClassPath))
+	{
+		if (UClass* Loaded = LoadClass<AEnemyBase>(nullptr, *ClassPath))
+		{
+			EnemyClass = Loaded;
+		}
+		else
+		{
+			AddWarning(FString::Printf(TEXT("Enemy class '%s' not found — using AEnemyBase."), *ClassPath));
+		}
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// UEnemyAIManager targets the first player controller's pawn.
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APlayerController* PC = World->SpawnActor<APlayerController>(Params);
+	ABaseCharacter* Player = World->SpawnActor<ABaseCharacter>(FVector(0.f, 0.f, 200.f), FRotator::ZeroRotator, Params);
+	if (!TestNotNull(TEXT("Player controller"), PC) || !TestNotNull(TEXT("Player stand-in"), Player)
+		|| !TestNotNull(TEXT("Enemy AI manager"), World->GetSubsystem<UEnemyAIManager>()))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+	PC->Possess(Player);
+
+	{
+		FEnemyAIBenchmark Benchmark(World, Player, EnemyClass, Frames, WarmUpFrames);
+		const FBenchCountResult Result = Benchmark.Run(Count);
+		TestEqual(TEXT("Enemies spawned"), Result.Count, Count);
+		AddInfo(FEnemyAIBenchmark::Summarize(Result));
+
+		const FString Path = FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+			/ FString::Printf(TEXT("EnemyAI_%d_%s.json"), Count, *FDateTime::Now().ToString());
+		if (TestTrue(TEXT("Report written"), FFileHelper::SaveStringToFile(Benchmark.BuildReport(Result), *Path)))
+		{
+			AddInfo(FString::Printf(TEXT("Report written to %s"), *FPaths::ConvertRelativePathToFull(Path)));
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
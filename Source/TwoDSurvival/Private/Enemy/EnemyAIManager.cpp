@@ -0,0 +1,1105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyAIManager.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyMoverComponent.h"
+#include "Character/BaseCharacter.h"
+#include "World/FlashlightActor.h"
+#include "World/BuildingGenerator.h"
+#include "World/ActorSpatialIndex.h"
+#include "World/OcclusionSpanCache.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("Enemy AI"), STATGROUP_EnemyAI, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Critical"), STAT_EnemyAI_Critical, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Near"), STAT_EnemyAI_Near, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Far"), STAT_EnemyAI_Far, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dormant"), STAT_EnemyAI_Dormant, STATGROUP_EnemyAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decided This Frame"), STAT_EnemyAI_Decided, STATGROUP_EnemyAI);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Subsystem
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UEnemyAIManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAIManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	WorldOffsetHandle = FWorldDelegates::OnPostWorldOriginOffset.AddUObject(this, &UEnemyAIManager::OnWorldOriginOffset);
+}
+
+void UEnemyAIManager::Deinitialize()
+{
+	FWorldDelegates::OnPostWorldOriginOffset.Remove(WorldOffsetHandle);
+	Scent.Reset();
+
+	for (AEnemyBase* Enemy : Enemies)
+	{
+		if (Enemy) Enemy->AISlot = INDEX_NONE;
+	}
+	Enemies.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UEnemyAIManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAIManager, STATGROUP_EnemyAI);
+}
+
+const FEnemySignificanceTick& UEnemyAIManager::GetTickSettings(EEnemySignificance Bucket) const
+{
+	switch (Bucket)
+	{
+	case EEnemySignificance::Critical: return CriticalTick;
+	case EEnemySignificance::Near:     return NearTick;
+	case EEnemySignificance::Far:      return FarTick;
+	default:                           return DormantTick;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Registration
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::RegisterEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy || Enemy->AISlot != INDEX_NONE) return;
+
+	const FVector Location = Enemy->GetActorLocation();
+
+	Enemy->AISlot = Enemies.Add(Enemy);
+	Positions.Add(Location);
+	States.Add(Enemy->CurrentState);
+	StateTimers.Add(0.f);
+	Targets.Add(Enemy->CachedPlayer);
+	TargetLocations.Add(Location);
+	DetectionRanges.Add(Enemy->AggroRange);
+	MaxDetectionRange = FMath::Max(MaxDetectionRange, Enemy->AggroRange);
+	SpawnX.Add(Location.X);
+	AlertX.Add(Location.X);
+	AlertZ.Add(Location.Z);
+	DetourLocations.Add(Location);
+	PatrolDirs.Add(1.f);
+	Enemy->FacingSign = FMath::Abs(FRotator::NormalizeAxis(Enemy->GetActorRotation().Yaw)) > 90.f ? -1 : 1;
+	Facings.Add(Enemy->FacingSign);
+	Flags.Add(EEnemyAIFlags::None);
+	Buckets.Add(EEnemySignificance::Critical);
+	SinceDecide.Add(0.f);
+	Actions.Add(EEnemyAIAction::None);
+	MoveDirs.Add(0.f);
+	MoveSpeeds.Add(0.f);
+	FootOffsets.Add(Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+	CrowdLanes.Add(0);
+	GapsLeft.Add(MAX_flt);
+	GapsRight.Add(MAX_flt);
+	AttackRanks.Add(0);
+	++BucketPopulation[(int32)EEnemySignificance::Critical];
+
+	// Starts in Critical — its components too, not just whatever the Blueprint defaulted to.
+	ApplyBucketTicks(Enemy, EEnemySignificance::Critical);
+
+	FEnemyAIParams& P = Params.AddDefaulted_GetRef();
+	P.AttackRange          = Enemy->AttackRange;
+	P.PatrolRange          = Enemy->PatrolRange;
+	P.LoseAggroMultiplier  = Enemy->LoseAggroMultiplier;
+	P.IdleWaitTime         = Enemy->IdleWaitTime;
+	P.AlertInvestigateTime = Enemy->AlertInvestigateTime;
+	P.PatrolSpeed          = Enemy->PatrolSpeed;
+	P.AlertSpeed           = Enemy->AlertSpeed;
+	P.ChaseSpeed           = Enemy->ChaseSpeed;
+}
+
+void UEnemyAIManager::UnregisterEnemy(AEnemyBase* Enemy)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->AISlot) || Enemies[Enemy->AISlot] != Enemy) return;
+
+	const int32 Slot = Enemy->AISlot;
+	Enemy->AISlot = INDEX_NONE;
+
+	// Full-rate components again — the death montage should play smoothly wherever it happens.
+	--BucketPopulation[(int32)Buckets[Slot]];
+	ApplyBucketTicks(Enemy, EEnemySignificance::Critical);
+
+	if (bUpdating)
+	{
+		Enemies[Slot] = nullptr;
+		PendingRemovals.Add(Slot);
+		return;
+	}
+	RemoveSlot(Slot);
+}
+
+void UEnemyAIManager::RemoveSlot(int32 Slot)
+{
+	Enemies.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	States.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	StateTimers.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Targets.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	TargetLocations.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	DetectionRanges.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	SpawnX.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	AlertX.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	AlertZ.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	DetourLocations.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	PatrolDirs.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Facings.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Params.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Buckets.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	SinceDecide.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Actions.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	MoveDirs.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	MoveSpeeds.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	FootOffsets.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	CrowdLanes.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	GapsLeft.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	GapsRight.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	AttackRanks.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+
+	// The last enemy moved into the hole — point it at its new slot.
+	if (Enemies.IsValidIndex(Slot) && Enemies[Slot])
+	{
+		Enemies[Slot]->AISlot = Slot;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Events
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::HearNoise(AEnemyBase* Enemy, const FVector& Origin)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->AISlot)) return;
+	NotifyNoise(Enemy->AISlot, Origin);
+}
+
+void UEnemyAIManager::NotifyNoise(int32 Slot, const FVector& Origin)
+{
+	// Already actively engaging — no need to downgrade to investigation.
+	if (States[Slot] == EEnemyState::Chase  ||
+		States[Slot] == EEnemyState::Attack ||
+		States[Slot] == EEnemyState::Dead)
+	{
+		return;
+	}
+
+	// A second noise while investigating restarts the walk toward the newer one.
+	AlertX[Slot] = Origin.X;
+	AlertZ[Slot] = Origin.Z;
+	StateTimers[Slot] = 0.f;
+	Flags[Slot] &= ~EEnemyAIFlags::ReachedAlert;
+	Flags[Slot] |= EEnemyAIFlags::Wake;
+	SetState(Slot, EEnemyState::Alert);
+}
+
+void UEnemyAIManager::ReportNoise(const FVector& Origin, float Radius)
+{
+	if (Radius <= 0.f) return;
+
+	for (FNoiseEvent& Queued : NoiseQueue)
+	{
+		if (FVector::DistSquared(Queued.Origin, Origin) <= FMath::Square(NoiseCoalesceDistance))
+		{
+			if (Radius > Queued.Radius)
+			{
+				Queued.Origin = Origin;
+				Queued.Radius = Radius;
+			}
+			return;
+		}
+	}
+	NoiseQueue.Add({ Origin, Radius });
+}
+
+void UEnemyAIManager::AggroOn(AEnemyBase* Enemy, ABaseCharacter* Attacker)
+{
+	if (!Enemy || !Attacker || !Enemies.IsValidIndex(Enemy->AISlot)) return;
+	const int32 Slot = Enemy->AISlot;
+
+	Targets[Slot] = Attacker;
+	Enemy->CachedPlayer = Attacker;
+	if (States[Slot] != EEnemyState::Attack)
+	{
+		SetState(Slot, EEnemyState::Chase);
+	}
+}
+
+void UEnemyAIManager::ForceState(AEnemyBase* Enemy, EEnemyState NewState)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->AISlot)) return;
+	SetState(Enemy->AISlot, NewState);
+}
+
+bool UEnemyAIManager::GetPatrolAnchors(const AEnemyBase* Enemy, float& OutSpawnX, float& OutAlertX) const
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->AISlot)) return false;
+	OutSpawnX = SpawnX[Enemy->AISlot];
+	OutAlertX = AlertX[Enemy->AISlot];
+	return true;
+}
+
+void UEnemyAIManager::SetPatrolAnchors(AEnemyBase* Enemy, float InSpawnX, float InAlertX)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->AISlot)) return;
+	SpawnX[Enemy->AISlot] = InSpawnX;
+	AlertX[Enemy->AISlot] = InAlertX;
+}
+
+void UEnemyAIManager::SetState(int32 Slot, EEnemyState NewState)
+{
+	if (States[Slot] == NewState) return;
+	States[Slot] = NewState;
+	StateTimers[Slot] = 0.f;
+	Flags[Slot] |= EEnemyAIFlags::Wake;
+
+	if (AEnemyBase* Enemy = Enemies[Slot])
+	{
+		Enemy->SetEnemyState(NewState);
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Batched update
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::Tick(float DeltaTime)
+{
+	LastPhaseTimings = FEnemyAIPhaseTimings();
+
+	double PhaseStart = FPlatformTime::Seconds();
+	auto EndPhase = [&PhaseStart](double& OutMs)
+	{
+		const double PhaseEnd = FPlatformTime::Seconds();
+		OutMs = (PhaseEnd - PhaseStart) * 1000.0;
+		PhaseStart = PhaseEnd;
+	};
+
+	UWorld* World = GetWorld();
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	ABaseCharacter* Player = PC ? Cast<ABaseCharacter>(PC->GetPawn()) : nullptr;
+	const FVector PlayerLocation = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+	// The trail is laid even with no enemies around, for the ones that spawn onto it.
+	UpdateScent(Player, PlayerLocation, (float)Now);
+
+	const int32 Count = Enemies.Num();
+	if (Count == 0) return;
+
+	FEnemyAIFrameSnapshot Frame;
+	Frame.bHasPlayer = Player != nullptr;
+	Frame.PlayerLocation = PlayerLocation;
+	Frame.Time = (float)Now;
+	if (const AFlashlightActor* Flashlight = Player ? Player->EquippedFlashlight.Get() : nullptr)
+	{
+		Frame.bFlashlightOn = Flashlight->GetCone(Frame.LightOrigin, Frame.LightForward, Frame.LightCosHalfAngle);
+	}
+	if (UOcclusionSpanCache* Occlusion = World ? World->GetSubsystem<UOcclusionSpanCache>() : nullptr)
+	{
+		Frame.Occlusion = &Occlusion->GetSpans();
+	}
+
+	bUpdating = true;
+
+	// ── Gather ────────────────────────────────────────────────────────────────
+	for (int32 i = 0; i < Count; ++i)
+	{
+		AEnemyBase* Enemy = Enemies[i];
+		if (!Enemy) continue;
+
+		Positions[i] = Enemy->GetActorLocation();
+		Enemy->CurrentSpeed = Enemy->GetVelocity().Size();
+
+		// Combat stamps are checked every frame whatever the bucket, so the swing window and
+		// cooldown stay frame-accurate when decides are throttled.
+		Enemy->ExpireCombatStamps(Now);
+
+		EEnemyAIFlags& F = Flags[i];
+		F &= EEnemyAIFlags::ReachedAlert | EEnemyAIFlags::Wake;
+		if (Enemy->CanAttackAt(Now))        F |= EEnemyAIFlags::CanAttack;
+		if (Enemy->bIsAttacking)            F |= EEnemyAIFlags::Attacking;
+		if (Enemy->IsMoveLockedAt(Now))     F |= EEnemyAIFlags::MoveLocked;
+		if (Enemy->IsRotationLockedAt(Now)) F |= EEnemyAIFlags::RotationLocked;
+
+		if (const ABaseCharacter* Target = Targets[i].Get())
+		{
+			F |= EEnemyAIFlags::HasTarget;
+			TargetLocations[i] = Target == Player ? PlayerLocation : Target->GetActorLocation();
+		}
+	}
+
+	// Target acquisition: flag the enemies close enough along X to possibly see the player
+	// (flashlight doubles the range) — everyone else skips detection entirely.
+	if (Player)
+	{
+		const float Reach = MaxDetectionRange * 2.f;
+		if (const UActorSpatialIndex* Index = World->GetSubsystem<UActorSpatialIndex>())
+		{
+			Index->ForEachInRange(EActorIndexCategory::Enemy, PlayerLocation.X - Reach, PlayerLocation.X + Reach,
+				[this](AActor* Actor)
+				{
+					const int32 Slot = static_cast<AEnemyBase*>(Actor)->AISlot;
+					if (Flags.IsValidIndex(Slot)) Flags[Slot] |= EEnemyAIFlags::PlayerNearby;
+				});
+		}
+		else
+		{
+			for (EEnemyAIFlags& F : Flags) F |= EEnemyAIFlags::PlayerNearby;
+		}
+	}
+
+	GatherDetours();
+
+	EndPhase(LastPhaseTimings.GatherMs);
+
+	PropagateNoise();
+	EndPhase(LastPhaseTimings.NoiseMs);
+
+	SignificanceTimer += DeltaTime;
+	if (SignificanceTimer >= SignificanceInterval)
+	{
+		SignificanceTimer = 0.f;
+		UpdateSignificance(Player, PlayerLocation);
+	}
+	EndPhase(LastPhaseTimings.SignificanceMs);
+
+	UpdateCrowd();
+	EndPhase(LastPhaseTimings.CrowdMs);
+
+	// ── Decide ────────────────────────────────────────────────────────────────
+	// Each slot reads Frame and its own entries and writes only its own entries, so the result
+	// doesn't depend on how slots are split across threads.
+	const float AIIntervals[(int32)EEnemySignificance::Num] = {
+		CriticalTick.AIInterval, NearTick.AIInterval, FarTick.AIInterval, DormantTick.AIInterval };
+
+	std::atomic<int32> Decided = 0;
+	ParallelFor(TEXT("EnemyAI.Decide"), Count, DecideBatchSize,
+		[this, DeltaTime, &Frame, &AIIntervals, &Decided](int32 i)
+		{
+			if (!Enemies[i]) return;
+
+			// One-shot actions fired last frame; a held Move keeps walking until the next decide.
+			Actions[i] &= EEnemyAIAction::Move;
+			SinceDecide[i] += DeltaTime;
+
+			if (!EnumHasAnyFlags(Flags[i], EEnemyAIFlags::Wake)
+				&& SinceDecide[i] < AIIntervals[(int32)Buckets[i]])
+			{
+				return;
+			}
+
+			Flags[i] &= ~EEnemyAIFlags::Wake;
+			Actions[i] = EEnemyAIAction::None;
+			DecideSlot(i, SinceDecide[i], Frame);
+			SinceDecide[i] = 0.f;
+			Decided.fetch_add(1, std::memory_order_relaxed);
+		},
+		Count >= ParallelDecideMinEnemies ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	SET_DWORD_STAT(STAT_EnemyAI_Decided, Decided.load());
+	EndPhase(LastPhaseTimings.DecideMs);
+
+	// ── Write-back ────────────────────────────────────────────────────────────
+	for (int32 i = 0; i < Count; ++i)
+	{
+		AEnemyBase* Enemy = Enemies[i];
+		if (!Enemy) continue;
+
+		const EEnemyAIAction A = Actions[i];
+		if (EnumHasAnyFlags(A, EEnemyAIAction::TargetPlayer))
+		{
+			Targets[i] = Player;
+		}
+		else if (EnumHasAnyFlags(A, EEnemyAIAction::DropTarget))
+		{
+			Targets[i] = nullptr;
+		}
+
+		if (Enemy->CurrentState != States[i])
+		{
+			Enemy->SetEnemyState(States[i]);
+		}
+		if (Enemy->CachedPlayer != Targets[i])
+		{
+			Enemy->CachedPlayer = Targets[i];
+		}
+
+		if (EnumHasAnyFlags(A, EEnemyAIAction::Stop))
+		{
+			Enemy->GetCharacterMovement()->StopMovementImmediately();
+		}
+		// Same X, on the floor of the room the stairs lead to.
+		if (EnumHasAnyFlags(A, EEnemyAIAction::Climb))
+		{
+			const FVector Landing(Positions[i].X, Positions[i].Y, DetourLocations[i].Z + FootOffsets[i]);
+			Enemy->SetActorLocation(Landing, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+		// A held Move stops short of a neighbour that has come within SeparationRadius since the decide.
+		if (EnumHasAnyFlags(A, EEnemyAIAction::Move) && !IsCrowdBlocked(i, MoveDirs[i]))
+		{
+			Enemy->GetCharacterMovement()->MaxWalkSpeed = MoveSpeeds[i];
+			Enemy->AddMovementInput(FVector(MoveDirs[i], 0.f, 0.f), 1.f);
+		}
+
+		// The kinematic mover doesn't sweep by default — tell it how close the nearest pawn is.
+		float PawnGap = FMath::Min(GapsLeft[i], GapsRight[i]);
+		if (Frame.bHasPlayer && FMath::Abs(Frame.PlayerLocation.Z - Positions[i].Z) < CrowdLaneHeight)
+		{
+			PawnGap = FMath::Min(PawnGap, FMath::Abs(Frame.PlayerLocation.X - Positions[i].X));
+		}
+		Enemy->Mover->SetNearestPawnGap(PawnGap);
+		if (Enemy->FacingSign != Facings[i])
+		{
+			Enemy->FacingSign = Facings[i];
+			Enemy->SetActorRotation(Facings[i] > 0 ? FRotator(0.f, 0.f, 0.f) : FRotator(0.f, 180.f, 0.f));
+		}
+		if (EnumHasAnyFlags(A, EEnemyAIAction::BeginAttack))
+		{
+			Enemy->BeginMeleeAttack();
+		}
+	}
+
+	bUpdating = false;
+
+	if (PendingRemovals.Num() > 0)
+	{
+		// Highest slot first so each swap pulls from a slot that is still live or already handled.
+		PendingRemovals.Sort(TGreater<int32>());
+		for (int32 Slot : PendingRemovals)
+		{
+			RemoveSlot(Slot);
+		}
+		PendingRemovals.Reset();
+	}
+	EndPhase(LastPhaseTimings.WriteBackMs);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Noise
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::PropagateNoise()
+{
+	if (NoiseQueue.Num() == 0) return;
+
+	const UActorSpatialIndex* Index = GetWorld()->GetSubsystem<UActorSpatialIndex>();
+	if (!Index)
+	{
+		NoiseQueue.Reset();
+		return;
+	}
+
+	TArray<const ABuildingGenerator*> Buildings;
+	for (TActorIterator<ABuildingGenerator> It(GetWorld()); It; ++It)
+	{
+		Buildings.Add(*It);
+	}
+
+	// (building, room node), or (INDEX_NONE, INDEX_NONE) outdoors.
+	auto Locate = [&Buildings](const FVector& WorldPos)
+	{
+		for (int32 b = 0; b < Buildings.Num(); ++b)
+		{
+			const int32 Node = Buildings[b]->GetRoomAt(WorldPos);
+			if (Node != INDEX_NONE) return FIntPoint(b, Node);
+		}
+		return FIntPoint(INDEX_NONE, INDEX_NONE);
+	};
+
+	// Share of the noise reaching To from From. Between two buildings it goes out one
+	// entrance and in through the other.
+	auto Transmission = [this, &Buildings](const FIntPoint& From, const FIntPoint& To)
+	{
+		if (From == To) return 1.f;
+
+		float Factor = 1.f;
+		if (From.X != INDEX_NONE)
+		{
+			const FBuildingRoomGraph& Graph = Buildings[From.X]->GetRoomGraph();
+			const int32 Exit = From.X == To.X ? To.Y : Graph.GetOutsideNode();
+			Factor *= Graph.GetNoiseTransmission(From.Y, Exit, ClosedDoorNoiseFactor, FloorSlabNoiseFactor);
+		}
+		if (To.X != INDEX_NONE && To.X != From.X)
+		{
+			const FBuildingRoomGraph& Graph = Buildings[To.X]->GetRoomGraph();
+			Factor *= Graph.GetNoiseTransmission(Graph.GetOutsideNode(), To.Y, ClosedDoorNoiseFactor, FloorSlabNoiseFactor);
+		}
+		return Factor;
+	};
+
+	for (const FNoiseEvent& Noise : NoiseQueue)
+	{
+		const FIntPoint From = Locate(Noise.Origin);
+		const float RadiusSq = FMath::Square(Noise.Radius);
+
+		Index->ForEachInRange(EActorIndexCategory::Enemy, Noise.Origin.X - Noise.Radius, Noise.Origin.X + Noise.Radius,
+			[&](AActor* Actor)
+			{
+				const int32 Slot = static_cast<AEnemyBase*>(Actor)->AISlot;
+				if (!Enemies.IsValidIndex(Slot) || !Enemies[Slot]) return;
+
+				const float DistSq = FVector::DistSquared(Noise.Origin, Positions[Slot]);
+				if (DistSq > RadiusSq) return;
+
+				const float Factor = Transmission(From, Locate(Positions[Slot]));
+				if (DistSq <= RadiusSq * FMath::Square(Factor))
+				{
+					NotifyNoise(Slot, Noise.Origin);
+				}
+			});
+	}
+	NoiseQueue.Reset();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rooms
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::GatherDetours()
+{
+	TArray<const ABuildingGenerator*> Buildings;
+	for (TActorIterator<ABuildingGenerator> It(GetWorld()); It; ++It)
+	{
+		Buildings.Add(*It);
+	}
+	if (Buildings.Num() == 0) return;
+
+	for (int32 i = 0; i < Enemies.Num(); ++i)
+	{
+		if (!Enemies[i]) continue;
+
+		// Chasers and attackers go for the target, investigators for the noise until they get there.
+		const EEnemyAIFlags F = Flags[i];
+		FVector Goal;
+		if ((States[i] == EEnemyState::Chase || States[i] == EEnemyState::Attack)
+			&& EnumHasAnyFlags(F, EEnemyAIFlags::HasTarget))
+		{
+			Goal = TargetLocations[i];
+		}
+		else if (States[i] == EEnemyState::Alert && !EnumHasAnyFlags(F, EEnemyAIFlags::ReachedAlert))
+		{
+			Goal = FVector(AlertX[i], Positions[i].Y, AlertZ[i]);
+		}
+		else
+		{
+			continue;
+		}
+
+		for (const ABuildingGenerator* Building : Buildings)
+		{
+			const int32 From = Building->GetRoomAt(Positions[i]);
+			const int32 To   = Building->GetRoomAt(Goal);
+			if (From == INDEX_NONE && To == INDEX_NONE) continue;
+			if (From == To) break;
+
+			// Outside the floors is the street — in through an entrance or out of one.
+			const FBuildingRoomGraph& Graph = Building->GetRoomGraph();
+			const int32 Start = From != INDEX_NONE ? From : Graph.GetOutsideNode();
+			const int32 End   = To != INDEX_NONE ? To : Graph.GetOutsideNode();
+			const int32 Next  = Graph.GetNextHop(Start, End);
+
+			// Behind a closed door, or out onto the street — head straight for the goal. So does a
+			// goal in the room next door on the same floor: nothing stands between them.
+			const FRoomLink* Link = Next != INDEX_NONE ? Graph.FindLink(Start, Next) : nullptr;
+			const bool bClimb = Link && Link->Kind == ERoomLinkKind::Stairs;
+			if (Next != INDEX_NONE && Next != Graph.GetOutsideNode() && (Next != End || bClimb))
+			{
+				Flags[i] |= bClimb ? EEnemyAIFlags::Detour | EEnemyAIFlags::Climb : EEnemyAIFlags::Detour;
+				DetourLocations[i] = Building->GetRoomLocation(Next);
+			}
+			break;
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Significance
+// ─────────────────────────────────────────────────────────────────────────────
+
+FIntPoint UEnemyAIManager::GetFloorContext(const TArray<const ABuildingGenerator*>& Buildings, const FVector& WorldPos)
+{
+	for (int32 b = 0; b < Buildings.Num(); ++b)
+	{
+		const int32 Floor = Buildings[b]->GetFloorAt(WorldPos);
+		if (Floor != INDEX_NONE) return FIntPoint(b, Floor);
+	}
+	return FIntPoint(INDEX_NONE, INDEX_NONE);
+}
+
+void UEnemyAIManager::UpdateSignificance(const ABaseCharacter* Player, const FVector& PlayerLocation)
+{
+	TArray<const ABuildingGenerator*> Buildings;
+	for (TActorIterator<ABuildingGenerator> It(GetWorld()); It; ++It)
+	{
+		Buildings.Add(*It);
+	}
+	const FIntPoint PlayerFloor = Player ? GetFloorContext(Buildings, PlayerLocation) : FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	auto ByDistance = [this](float Dist)
+	{
+		return Dist < CriticalDistance ? EEnemySignificance::Critical
+			: Dist < NearDistance      ? EEnemySignificance::Near
+			: Dist < FarDistance       ? EEnemySignificance::Far
+			:                            EEnemySignificance::Dormant;
+	};
+
+	for (int32 i = 0; i < Enemies.Num(); ++i)
+	{
+		AEnemyBase* Enemy = Enemies[i];
+		if (!Enemy) continue;
+
+		const EEnemySignificance Current = Buckets[i];
+		EEnemySignificance New = EEnemySignificance::Critical;
+
+		if (States[i] != EEnemyState::Chase && States[i] != EEnemyState::Attack)
+		{
+			// Promote as soon as a threshold is crossed; demote only once past it by the margin.
+			const float Dist = Player ? FVector::Dist(Positions[i], PlayerLocation) : TNumericLimits<float>::Max();
+			New = ByDistance(Dist);
+			if (New > Current)
+			{
+				New = FMath::Max(Current, ByDistance(Dist - SignificanceHysteresis));
+			}
+
+			// Another floor, or indoors while the player is outdoors (or vice versa).
+			if (GetFloorContext(Buildings, Positions[i]) != PlayerFloor)
+			{
+				New = FMath::Max(New, EEnemySignificance::Far);
+			}
+
+			// Walking to a noise needs a fine decide rate to stop within 50 cm of it.
+			if (Enemy->WasRecentlyRendered(OnScreenTolerance) || States[i] == EEnemyState::Alert)
+			{
+				New = FMath::Min(New, EEnemySignificance::Near);
+			}
+		}
+
+		if (New == Current) continue;
+
+		--BucketPopulation[(int32)Current];
+		++BucketPopulation[(int32)New];
+		Buckets[i] = New;
+		ApplyBucketTicks(Enemy, New);
+
+		if (New < Current)
+		{
+			Flags[i] |= EEnemyAIFlags::Wake;
+		}
+		else
+		{
+			// Spread the first slow decides across the interval so a batch demoted on the same
+			// re-score doesn't decide on the same frame forever after.
+			SinceDecide[i] = FMath::FRand() * GetTickSettings(New).AIInterval;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_EnemyAI_Critical, BucketPopulation[(int32)EEnemySignificance::Critical]);
+	SET_DWORD_STAT(STAT_EnemyAI_Near,     BucketPopulation[(int32)EEnemySignificance::Near]);
+	SET_DWORD_STAT(STAT_EnemyAI_Far,      BucketPopulation[(int32)EEnemySignificance::Far]);
+	SET_DWORD_STAT(STAT_EnemyAI_Dormant,  BucketPopulation[(int32)EEnemySignificance::Dormant]);
+}
+
+void UEnemyAIManager::ApplyBucketTicks(AEnemyBase* Enemy, EEnemySignificance Bucket) const
+{
+	const FEnemySignificanceTick& Settings = GetTickSettings(Bucket);
+	Enemy->GetCharacterMovement()->SetComponentTickInterval(Settings.MovementInterval);
+	Enemy->Mover->SetComponentTickInterval(Settings.MovementInterval);
+	if (USkeletalMeshComponent* Mesh = Enemy->GetMesh())
+	{
+		Mesh->SetComponentTickInterval(Settings.AnimationInterval);
+		Mesh->VisibilityBasedAnimTickOption = Settings.VisibilityTickOption;
+
+		// Every LOD maps to the bucket's rate, so significance — not screen size — sets it.
+		// Only present if URO was enabled before the mesh registered (AEnemyBase's constructor).
+		if (FAnimUpdateRateParameters* URO = Mesh->AnimUpdateRateParams)
+		{
+			URO->bShouldUseLodMap = true;
+			URO->LODToFrameSkipMap.Reset();
+			for (int32 LOD = 0; LOD < MAX_SKELETAL_MESH_LODS; ++LOD)
+			{
+				URO->LODToFrameSkipMap.Add(LOD, Settings.AnimEvalRate - 1);
+			}
+			URO->BaseNonRenderedUpdateRate = Settings.NonRenderedAnimEvalRate;
+			URO->MaxEvalRateForInterpolation = Settings.bInterpolateSkippedFrames ? Settings.AnimEvalRate + 1 : 0;
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scent
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::UpdateScent(const ABaseCharacter* Player, const FVector& PlayerLocation, float Now)
+{
+	Scent.Configure(ScentBinWidth, ScentChunkWidth, CrowdLaneHeight);
+
+	// Airborne steps would land on a higher lane and leave a gap in the ground trail.
+	const UCharacterMovementComponent* Movement = Player ? Player->GetCharacterMovement() : nullptr;
+	if (Movement && Movement->IsMovingOnGround())
+	{
+		FVector Foot = PlayerLocation;
+		Foot.Z -= Player->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+		// On stairs the feet are between floors — inside a building the trail stays on the floor.
+		for (TActorIterator<ABuildingGenerator> It(GetWorld()); It; ++It)
+		{
+			const int32 Node = It->GetRoomAt(Foot);
+			if (Node != INDEX_NONE)
+			{
+				Foot.Z = It->GetRoomLocation(Node).Z;
+				break;
+			}
+		}
+
+		// Continuous if no longer than the player could have moved since the last deposit, so a
+		// landing bridges the trail back to the take-off.
+		const float MaxStep = ScentMaxStep + Movement->GetMaxSpeed() * FMath::Max(Now - LastScentTime, 0.f);
+		const bool bContinuous = LastScentTime >= 0.f
+			&& FVector::DistSquared(LastScentLocation, Foot) <= FMath::Square(MaxStep);
+		Scent.Deposit(bContinuous ? LastScentLocation : Foot, bContinuous ? LastScentTime : Now, Foot, Now);
+		LastScentLocation = Foot;
+		LastScentTime = Now;
+	}
+
+	// Age at which the trail drops below ScentFollowStrength.
+	Scent.Prune(Now - ScentHalfLife * FMath::Log2(1.f / ScentFollowStrength));
+}
+
+void UEnemyAIManager::OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin)
+{
+	if (InWorld != GetWorld()) return;
+
+	Scent.Reset();
+	LastScentTime = -1.f;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Crowd
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::UpdateCrowd()
+{
+	const int32 Count = Enemies.Num();
+	if (CrowdOrder.Num() != Count)
+	{
+		// Slots were added or removed — the order is rebuilt and sorted from scratch once.
+		CrowdOrder.SetNumUninitialized(Count);
+		for (int32 i = 0; i < Count; ++i) CrowdOrder[i] = i;
+	}
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		CrowdLanes[i] = FMath::FloorToInt(Positions[i].Z / CrowdLaneHeight);
+	}
+
+	auto Less = [this](int32 A, int32 B)
+	{
+		return CrowdLanes[A] != CrowdLanes[B] ? CrowdLanes[A] < CrowdLanes[B] : Positions[A].X < Positions[B].X;
+	};
+
+	// Insertion sort — enemies move a few cm per frame, so almost nothing shifts.
+	for (int32 k = 1; k < Count; ++k)
+	{
+		const int32 Slot = CrowdOrder[k];
+		int32 j = k - 1;
+		for (; j >= 0 && Less(Slot, CrowdOrder[j]); --j)
+		{
+			CrowdOrder[j + 1] = CrowdOrder[j];
+		}
+		CrowdOrder[j + 1] = Slot;
+	}
+
+	auto IsEngaged = [this](int32 Slot)
+	{
+		return Enemies[Slot] && EnumHasAnyFlags(Flags[Slot], EEnemyAIFlags::HasTarget)
+			&& (States[Slot] == EEnemyState::Chase || States[Slot] == EEnemyState::Attack);
+	};
+
+	// Engaged enemies counted so far per target, while walking away from it along one side.
+	TArray<TPair<const ABaseCharacter*, int32>, TInlineAllocator<4>> Counters;
+	auto NextRank = [&Counters](const ABaseCharacter* Target)
+	{
+		for (TPair<const ABaseCharacter*, int32>& Counter : Counters)
+		{
+			if (Counter.Key == Target) return Counter.Value++;
+		}
+		Counters.Add({ Target, 1 });
+		return 0;
+	};
+
+	for (int32 Begin = 0; Begin < Count;)
+	{
+		int32 End = Begin + 1;
+		while (End < Count && CrowdLanes[CrowdOrder[End]] == CrowdLanes[CrowdOrder[Begin]]) ++End;
+
+		int32 Prev = INDEX_NONE;
+		for (int32 k = Begin; k < End; ++k)
+		{
+			const int32 Slot = CrowdOrder[k];
+			AttackRanks[Slot] = 0;
+			GapsLeft[Slot] = MAX_flt;
+			GapsRight[Slot] = MAX_flt;
+			if (!Enemies[Slot]) continue;
+
+			if (Prev != INDEX_NONE)
+			{
+				const float Gap = Positions[Slot].X - Positions[Prev].X;
+				GapsLeft[Slot] = Gap;
+				GapsRight[Prev] = Gap;
+			}
+			Prev = Slot;
+		}
+
+		// Right of the target: rank grows walking right. Left of it: walking left.
+		Counters.Reset();
+		for (int32 k = Begin; k < End; ++k)
+		{
+			const int32 Slot = CrowdOrder[k];
+			if (IsEngaged(Slot) && Positions[Slot].X >= TargetLocations[Slot].X)
+			{
+				AttackRanks[Slot] = NextRank(Targets[Slot].Get());
+			}
+		}
+		Counters.Reset();
+		for (int32 k = End - 1; k >= Begin; --k)
+		{
+			const int32 Slot = CrowdOrder[k];
+			if (IsEngaged(Slot) && Positions[Slot].X < TargetLocations[Slot].X)
+			{
+				AttackRanks[Slot] = NextRank(Targets[Slot].Get());
+			}
+		}
+
+		Begin = End;
+	}
+}
+
+bool UEnemyAIManager::IsCrowdBlocked(int32 Slot, float DirX) const
+{
+	if (DirX > 0.f) return GapsRight[Slot] < SeparationRadius;
+	if (DirX < 0.f) return GapsLeft[Slot] < SeparationRadius;
+	return false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Decide
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyAIManager::DecideSlot(int32 Slot, float DeltaTime, const FEnemyAIFrameSnapshot& Frame)
+{
+	const FVector& Pos = Positions[Slot];
+	const FEnemyAIParams& P = Params[Slot];
+	const EEnemyAIFlags F = Flags[Slot];
+
+	// Array-only transition — the write-back pass applies SetEnemyState side effects.
+	auto Transition = [this, Slot](EEnemyState NewState)
+	{
+		States[Slot] = NewState;
+		StateTimers[Slot] = 0.f;
+	};
+
+	// Faces DirX, but only walks if that doesn't close on a neighbour (IsCrowdBlocked).
+	auto Move = [this, Slot](float DirX, float Speed)
+	{
+		Facings[Slot] = DirX > 0.f ? 1 : -1;
+		if (IsCrowdBlocked(Slot, DirX)) return;
+
+		Actions[Slot] |= EEnemyAIAction::Move;
+		MoveDirs[Slot] = DirX;
+		MoveSpeeds[Slot] = Speed;
+	};
+
+	// Moves toward GoalX — or, with the goal in another room (Detour), toward the next room on the
+	// path, taking the stairs when that room is on another floor.
+	auto MoveToward = [&](float GoalX, float Speed)
+	{
+		if (EnumHasAnyFlags(F, EEnemyAIFlags::Climb))
+		{
+			Actions[Slot] |= EEnemyAIAction::Climb;
+			return;
+		}
+		const float SteerX = EnumHasAnyFlags(F, EEnemyAIFlags::Detour) ? DetourLocations[Slot].X : GoalX;
+		Move(FMath::Sign(SteerX - Pos.X), Speed);
+	};
+
+	// Returns true (and targets the player) if the player is within detection range and in sight.
+	// Flashlight in cone doubles the range — the cone test only runs in the extra band, and the
+	// sight test only once the player is in range.
+	auto Detect = [&]()
+	{
+		if (!Frame.bHasPlayer || !EnumHasAnyFlags(F, EEnemyAIFlags::PlayerNearby)) return false;
+		const float Range = DetectionRanges[Slot];
+		const float DistSq = FVector::DistSquared(Pos, Frame.PlayerLocation);
+		const bool bSeen = (DistSq <= FMath::Square(Range)
+				|| (DistSq <= FMath::Square(Range * 2.f) && Frame.IsInLightCone(Pos)))
+			&& (!Frame.Occlusion || Frame.Occlusion->IsVisible(Pos, Frame.PlayerLocation));
+		if (bSeen)
+		{
+			Actions[Slot] |= EEnemyAIAction::TargetPlayer;
+			Flags[Slot] |= EEnemyAIFlags::HasTarget;
+			TargetLocations[Slot] = Frame.PlayerLocation;
+			Transition(EEnemyState::Chase);
+		}
+		return bSeen;
+	};
+
+	switch (States[Slot])
+	{
+	case EEnemyState::Idle:
+	{
+		if (Detect()) return;
+
+		StateTimers[Slot] += DeltaTime;
+		if (StateTimers[Slot] >= P.IdleWaitTime)
+		{
+			Transition(EEnemyState::Patrol);
+		}
+		break;
+	}
+	case EEnemyState::Patrol:
+	{
+		if (Detect()) return;
+
+		const float XFromSpawn = Pos.X - SpawnX[Slot];
+		if (XFromSpawn >= P.PatrolRange)  PatrolDirs[Slot] = -1.f;
+		if (XFromSpawn <= -P.PatrolRange) PatrolDirs[Slot] = 1.f;
+		if (IsCrowdBlocked(Slot, PatrolDirs[Slot])) PatrolDirs[Slot] = -PatrolDirs[Slot];
+
+		Move(PatrolDirs[Slot], P.PatrolSpeed);
+		break;
+	}
+	case EEnemyState::Alert:
+	{
+		// Visual detection during investigation upgrades immediately to Chase.
+		if (Detect()) return;
+
+		if (!EnumHasAnyFlags(F, EEnemyAIFlags::ReachedAlert))
+		{
+			// Walk toward the noise origin — or as close as the crowd around it allows. A noise in
+			// another room isn't reached by lining up with it on X.
+			const float DirX = FMath::Sign(AlertX[Slot] - Pos.X);
+			if (!EnumHasAnyFlags(F, EEnemyAIFlags::Detour)
+				&& (FMath::Abs(AlertX[Slot] - Pos.X) <= 50.f || IsCrowdBlocked(Slot, DirX)))
+			{
+				Flags[Slot] |= EEnemyAIFlags::ReachedAlert;
+				Actions[Slot] |= EEnemyAIAction::Stop;
+			}
+			else
+			{
+				MoveToward(AlertX[Slot], P.AlertSpeed);
+			}
+		}
+		else
+		{
+			// Follow the player's trail while it is fresh enough — each step is toward newer scent.
+			float Strength = 0.f;
+			const FVector Foot(Pos.X, Pos.Y, Pos.Z - FootOffsets[Slot]);
+			const int32 Uphill = Scent.GetUphillDir(Foot, Frame.Time, ScentHalfLife, Strength);
+			if (Uphill != 0 && Strength >= ScentFollowStrength && !IsCrowdBlocked(Slot, Uphill))
+			{
+				StateTimers[Slot] = 0.f;
+				Move(Uphill, P.AlertSpeed);
+				break;
+			}
+
+			// Stand and look around — give up after AlertInvestigateTime seconds.
+			StateTimers[Slot] += DeltaTime;
+			if (StateTimers[Slot] >= P.AlertInvestigateTime)
+			{
+				Transition(EEnemyState::Patrol);
+			}
+		}
+		break;
+	}
+	case EEnemyState::Chase:
+	{
+		if (!EnumHasAnyFlags(F, EEnemyAIFlags::HasTarget))
+		{
+			Transition(EEnemyState::Idle);
+			return;
+		}
+
+		const FVector& TargetLocation = TargetLocations[Slot];
+		if (FVector::DistSquared(Pos, TargetLocation) > FMath::Square(DetectionRanges[Slot] * P.LoseAggroMultiplier))
+		{
+			// Investigate where the target was last seen, then pick up its scent from there.
+			Actions[Slot] |= EEnemyAIAction::DropTarget;
+			AlertX[Slot] = TargetLocation.X;
+			AlertZ[Slot] = TargetLocation.Z;
+			Flags[Slot] &= ~EEnemyAIFlags::ReachedAlert;
+			Transition(EEnemyState::Alert);
+			return;
+		}
+
+		const bool bHasAttackSlot = AttackRanks[Slot] < AttackSlotsPerSide;
+		// Lined up on X doesn't count through a wall or a floor.
+		const bool bInRange = !EnumHasAnyFlags(F, EEnemyAIFlags::Detour)
+			&& FMath::Abs(TargetLocation.X - Pos.X) <= P.AttackRange;
+		if (bInRange && bHasAttackSlot && EnumHasAnyFlags(F, EEnemyAIFlags::CanAttack))
+		{
+			Transition(EEnemyState::Attack);
+			return;
+		}
+
+		// In range without a slot — wait here facing the target.
+		if (bInRange && !bHasAttackSlot)
+		{
+			Facings[Slot] = TargetLocation.X > Pos.X ? 1 : -1;
+			break;
+		}
+
+		MoveToward(TargetLocation.X, P.ChaseSpeed);
+		break;
+	}
+	case EEnemyState::Attack:
+	{
+		if (!EnumHasAnyFlags(F, EEnemyAIFlags::HasTarget))
+		{
+			Transition(EEnemyState::Idle);
+			return;
+		}
+
+		const FVector& TargetLocation = TargetLocations[Slot];
+		const float DirX = FMath::Sign(TargetLocation.X - Pos.X);
+
+		// Facing is locked for AttackRotationLockDuration seconds from swing start.
+		// After that window expires the enemy can face the player again before the next swing.
+		if (!EnumHasAnyFlags(F, EEnemyAIFlags::RotationLocked) && !FMath::IsNearlyZero(DirX))
+		{
+			Facings[Slot] = DirX > 0.f ? 1 : -1;
+		}
+
+		const bool bBusy = EnumHasAnyFlags(F, EEnemyAIFlags::Attacking | EEnemyAIFlags::MoveLocked);
+
+		// Player moved out of range or into another room, or a closer enemy took the slot — go
+		// back to chasing once the stand-still window ends
+		if ((FMath::Abs(TargetLocation.X - Pos.X) > P.AttackRange || AttackRanks[Slot] >= AttackSlotsPerSide
+				|| EnumHasAnyFlags(F, EEnemyAIFlags::Detour)) && !bBusy)
+		{
+			Transition(EEnemyState::Chase);
+			return;
+		}
+
+		// Initiate a new swing once both the cooldown and stand-still window have cleared
+		if (EnumHasAnyFlags(F, EEnemyAIFlags::CanAttack) && !bBusy)
+		{
+			Actions[Slot] |= EEnemyAIAction::BeginAttack;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
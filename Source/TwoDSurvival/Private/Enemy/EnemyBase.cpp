@@ -1,6 +1,9 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyAIManager.h"
+#include "Enemy/EnemyPool.h"
+#include "Enemy/EnemyMoverComponent.h"
 #include "Character/BaseCharacter.h"
 #include "Components/SkillComponent.h"
 #include "World/FlashlightActor.h"
@@ -16,7 +19,8 @@
 
 AEnemyBase::AEnemyBase()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// The state machine runs batched in UEnemyAIManager; movement and animation still tick.
+	PrimaryActorTick.bCanEverTick = false;
 
 	bUseControllerRotationYaw = false;
 	bUseControllerRotationPitch = false;
@@ -43,23 +47,29 @@ AEnemyBase::AEnemyBase()
 	HealthBarComp->SetDrawSize(FVector2D(100.f, 12.f));
 	HealthBarComp->SetVisibility(false); // Hidden until first damage hit
 
+	// Kinematic mover — ticks only when enabled on the Blueprint
+	Mover = CreateDefaultSubobject<UEnemyMoverComponent>(TEXT("Mover"));
+
 	// Constrain movement to the X/Z plane — same as the player character
 	GetCharacterMovement()->bConstrainToPlane = true;
 	GetCharacterMovement()->SetPlaneConstraintNormal(FVector(0.f, 1.f, 0.f));
 	GetCharacterMovement()->bSnapToPlaneAtStart = true;
 	GetCharacterMovement()->bOrientRotationToMovement = false;
+
+	// Animation update rate is set per significance bucket by UEnemyAIManager. URO has to be on
+	// before the mesh registers for its parameters to exist.
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 }
 
 void AEnemyBase::BeginPlay()
 {
 	Super::BeginPlay();
 
-	SpawnLocation = GetActorLocation();
-
 	MeleeHitbox->OnComponentBeginOverlap.AddDynamic(this, &AEnemyBase::OnMeleeHitboxOverlap);
 	HealthComp->OnDeath.AddDynamic(this, &AEnemyBase::OnEnemyDeath);
 
 	GetCharacterMovement()->MaxWalkSpeed = PatrolSpeed;
+	DefaultCapsuleCollision = GetCapsuleComponent()->GetCollisionEnabled();
 
 	// Create the health bar widget on the widget component
 	if (HealthBarWidgetClass)
@@ -68,204 +78,29 @@ void AEnemyBase::BeginPlay()
 		HealthBarComp->InitWidget();
 		HealthBarWidgetInstance = Cast<UEnemyHealthBarWidget>(HealthBarComp->GetWidget());
 	}
-}
-
-void AEnemyBase::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (CurrentState == EEnemyState::Dead) return;
 
-	CurrentSpeed = GetVelocity().Size();
-
-	switch (CurrentState)
+	// Patrol wanders around the location registered here.
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
 	{
-	case EEnemyState::Idle:   TickIdle(DeltaTime);   break;
-	case EEnemyState::Patrol: TickPatrol(DeltaTime); break;
-	case EEnemyState::Alert:  TickAlert(DeltaTime);  break;
-	case EEnemyState::Chase:  TickChase(DeltaTime);  break;
-	case EEnemyState::Attack: TickAttack(DeltaTime); break;
-	default: break;
+		AI->RegisterEnemy(this);
 	}
 }
 
-// --- Player Detection ---
-
-ABaseCharacter* AEnemyBase::DetectPlayer() const
+void AEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	UWorld* World = GetWorld();
-	if (!World) return nullptr;
-
-	APlayerController* PC = World->GetFirstPlayerController();
-	if (!PC) return nullptr;
-
-	ABaseCharacter* Player = Cast<ABaseCharacter>(PC->GetPawn());
-	if (!Player) return nullptr;
-
-	const float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-
-	// Flashlight in cone doubles aggro range — enemies spot the light source.
-	float EffectiveRange = AggroRange;
-	if (Player->EquippedFlashlight && Player->EquippedFlashlight->IsInCone(GetActorLocation()))
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
 	{
-		EffectiveRange *= 2.f;
+		AI->UnregisterEnemy(this);
 	}
 
-	return Dist <= EffectiveRange ? Player : nullptr;
-}
-
-// --- Per-State Tick ---
-
-void AEnemyBase::TickIdle(float DeltaTime)
-{
-	ABaseCharacter* Player = DetectPlayer();
-	if (Player)
-	{
-		CachedPlayer = Player;
-		SetEnemyState(EEnemyState::Chase);
-		return;
-	}
-
-	IdleTimer += DeltaTime;
-	if (IdleTimer >= IdleWaitTime)
-	{
-		SetEnemyState(EEnemyState::Patrol);
-	}
-}
-
-void AEnemyBase::TickPatrol(float DeltaTime)
-{
-	ABaseCharacter* Player = DetectPlayer();
-	if (Player)
-	{
-		CachedPlayer = Player;
-		SetEnemyState(EEnemyState::Chase);
-		return;
-	}
-
-	float XFromSpawn = GetActorLocation().X - SpawnLocation.X;
-	if (XFromSpawn >= PatrolRange)  PatrolDir = -1.f;
-	if (XFromSpawn <= -PatrolRange) PatrolDir = 1.f;
-
-	MoveInDirection(PatrolDir, PatrolSpeed);
-}
-
-void AEnemyBase::TickAlert(float DeltaTime)
-{
-	// Visual detection during investigation upgrades immediately to Chase.
-	if (ABaseCharacter* Player = DetectPlayer())
-	{
-		CachedPlayer = Player;
-		SetEnemyState(EEnemyState::Chase);
-		return;
-	}
-
-	const float XDist = FMath::Abs(AlertLocation.X - GetActorLocation().X);
-
-	if (!bReachedAlertLocation)
-	{
-		// Walk toward the noise origin.
-		if (XDist <= 50.f)
-		{
-			bReachedAlertLocation = true;
-			GetCharacterMovement()->StopMovementImmediately();
-		}
-		else
-		{
-			const float DirX = FMath::Sign(AlertLocation.X - GetActorLocation().X);
-			MoveInDirection(DirX, AlertSpeed);
-		}
-	}
-	else
-	{
-		// Stand and look around — give up after AlertInvestigateTime seconds.
-		AlertTimer += DeltaTime;
-		if (AlertTimer >= AlertInvestigateTime)
-		{
-			SetEnemyState(EEnemyState::Patrol);
-		}
-	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEnemyBase::HearNoise(FVector NoiseOrigin)
 {
-	// Already actively engaging — no need to downgrade to investigation.
-	if (CurrentState == EEnemyState::Chase  ||
-		CurrentState == EEnemyState::Attack ||
-		CurrentState == EEnemyState::Dead)
-	{
-		return;
-	}
-
-	AlertLocation = NoiseOrigin;
-	AlertTimer = 0.f;
-	bReachedAlertLocation = false;
-	SetEnemyState(EEnemyState::Alert);
-}
-
-void AEnemyBase::TickChase(float DeltaTime)
-{
-	if (!CachedPlayer.IsValid())
-	{
-		SetEnemyState(EEnemyState::Idle);
-		return;
-	}
-
-	ABaseCharacter* Player = CachedPlayer.Get();
-
-	float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-	if (Dist > AggroRange * LoseAggroMultiplier)
-	{
-		CachedPlayer = nullptr;
-		SetEnemyState(EEnemyState::Idle);
-		return;
-	}
-
-	float XDist = FMath::Abs(Player->GetActorLocation().X - GetActorLocation().X);
-	if (XDist <= AttackRange && bCanAttack)
-	{
-		SetEnemyState(EEnemyState::Attack);
-		return;
-	}
-
-	float DirX = FMath::Sign(Player->GetActorLocation().X - GetActorLocation().X);
-	MoveInDirection(DirX, ChaseSpeed);
-}
-
-void AEnemyBase::TickAttack(float DeltaTime)
-{
-	if (!CachedPlayer.IsValid())
-	{
-		SetEnemyState(EEnemyState::Idle);
-		return;
-	}
-
-	ABaseCharacter* Player = CachedPlayer.Get();
-
-	// Facing is locked for AttackRotationLockDuration seconds from swing start.
-	// After that window expires the enemy can face the player again before the next swing.
-	if (!bRotationLocked)
-	{
-		float DirX = FMath::Sign(Player->GetActorLocation().X - GetActorLocation().X);
-		if (!FMath::IsNearlyZero(DirX))
-		{
-			SetActorRotation(DirX > 0.f ? FRotator(0.f, 0.f, 0.f) : FRotator(0.f, 180.f, 0.f));
-		}
-	}
-
-	float XDist = FMath::Abs(Player->GetActorLocation().X - GetActorLocation().X);
-
-	// Player moved out of range — go back to chasing once the stand-still window ends
-	if (XDist > AttackRange && !bIsAttacking && !bPostAttackMoveLocked)
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
 	{
-		SetEnemyState(EEnemyState::Chase);
-		return;
-	}
-
-	// Initiate a new swing once both the cooldown and stand-still window have cleared
-	if (bCanAttack && !bIsAttacking && !bPostAttackMoveLocked)
-	{
-		BeginMeleeAttack();
+		AI->HearNoise(this, NoiseOrigin);
 	}
 }
 
@@ -280,7 +115,6 @@ void AEnemyBase::SetEnemyState(EEnemyState NewState)
 	switch (NewState)
 	{
 	case EEnemyState::Idle:
-		IdleTimer = 0.f;
 		GetCharacterMovement()->MaxWalkSpeed = PatrolSpeed;
 		break;
 	case EEnemyState::Patrol:
@@ -298,23 +132,13 @@ void AEnemyBase::SetEnemyState(EEnemyState NewState)
 		GetCharacterMovement()->MaxWalkSpeed = 0.f;
 		break;
 	case EEnemyState::Dead:
+		// Pending combat stamps lapse on their own — dead enemies leave the AI update.
 		GetCharacterMovement()->StopMovementImmediately();
 		GetCharacterMovement()->MaxWalkSpeed = 0.f;
-		GetWorldTimerManager().ClearTimer(SwingTimerHandle);
-		GetWorldTimerManager().ClearTimer(AttackCooldownTimer);
-		GetWorldTimerManager().ClearTimer(PostAttackMoveTimer);
-		GetWorldTimerManager().ClearTimer(RotationLockTimer);
 		break;
 	}
 }
 
-void AEnemyBase::MoveInDirection(float DirX, float Speed)
-{
-	GetCharacterMovement()->MaxWalkSpeed = Speed;
-	AddMovementInput(FVector(DirX, 0.f, 0.f), 1.f);
-	SetActorRotation(DirX > 0.f ? FRotator(0.f, 0.f, 0.f) : FRotator(0.f, 180.f, 0.f));
-}
-
 // --- Combat ---
 
 void AEnemyBase::BeginMeleeAttack()
@@ -322,14 +146,13 @@ void AEnemyBase::BeginMeleeAttack()
 	// Guard: don't start a new swing if hitbox is already active
 	if (MeleeHitbox->GetCollisionEnabled() != ECollisionEnabled::NoCollision) return;
 
+	const double Now = GetWorld()->GetTimeSeconds();
+
 	bIsAttacking = true;
-	bCanAttack = false;
-	bPostAttackMoveLocked = true;
-	bRotationLocked = true;
 	HitActorsThisSwing.Empty();
 
 	// Hitbox is NOT enabled here — AnimNotify_BeginAttack fires at the correct hit frame.
-	// SwingTimerHandle acts as a safety fallback to close the hitbox if the notify is missed.
+	// SwingEndTime acts as a safety fallback to close the hitbox if the notify is missed.
 
 	if (AttackMontage && GetMesh() && GetMesh()->GetAnimInstance())
 	{
@@ -337,13 +160,25 @@ void AEnemyBase::BeginMeleeAttack()
 	}
 
 	// Unlock attack input after cooldown
-	GetWorldTimerManager().SetTimer(AttackCooldownTimer, this, &AEnemyBase::ResetAttackCooldown, AttackCooldown, false);
+	AttackReadyTime = Now + AttackCooldown;
 
 	// Unlock movement after cooldown + extra stand-still window
-	GetWorldTimerManager().SetTimer(PostAttackMoveTimer, this, &AEnemyBase::OnPostAttackMoveUnlocked, AttackCooldown + PostAttackStandStillDuration, false);
+	MoveUnlockTime = Now + AttackCooldown + PostAttackStandStillDuration;
 
 	// Unlock rotation after configurable duration
-	GetWorldTimerManager().SetTimer(RotationLockTimer, this, &AEnemyBase::OnRotationLockExpired, AttackRotationLockDuration, false);
+	RotationUnlockTime = Now + AttackRotationLockDuration;
+}
+
+void AEnemyBase::ExpireCombatStamps(double Now)
+{
+	if (SwingEndTime > 0.0 && Now >= SwingEndTime)
+	{
+		DisableMeleeHitbox();
+	}
+	if (bIsAttacking && Now >= AttackReadyTime)
+	{
+		bIsAttacking = false;
+	}
 }
 
 void AEnemyBase::EnableMeleeHitbox()
@@ -353,34 +188,13 @@ void AEnemyBase::EnableMeleeHitbox()
 	MeleeHitbox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 
 	// Safety fallback: auto-close after SwingWindowDuration if EndAttack notify is absent
-	GetWorldTimerManager().SetTimer(SwingTimerHandle, this, &AEnemyBase::DisableMeleeHitbox, SwingWindowDuration, false);
+	SwingEndTime = GetWorld()->GetTimeSeconds() + SwingWindowDuration;
 }
 
 void AEnemyBase::DisableMeleeHitbox()
 {
 	MeleeHitbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	GetWorldTimerManager().ClearTimer(SwingTimerHandle);
-}
-
-void AEnemyBase::EndMeleeAttack()
-{
-	DisableMeleeHitbox();
-}
-
-void AEnemyBase::ResetAttackCooldown()
-{
-	bIsAttacking = false;
-	bCanAttack = true;
-}
-
-void AEnemyBase::OnPostAttackMoveUnlocked()
-{
-	bPostAttackMoveLocked = false;
-}
-
-void AEnemyBase::OnRotationLockExpired()
-{
-	bRotationLocked = false;
+	SwingEndTime = 0.0;
 }
 
 void AEnemyBase::OnMeleeHitboxOverlap(
@@ -418,14 +232,30 @@ void AEnemyBase::TakeMeleeDamage_Implementation(float Amount, AActor* DamageSour
 	// Aggro the attacker if we haven't already
 	if (ABaseCharacter* Attacker = Cast<ABaseCharacter>(DamageSource))
 	{
-		CachedPlayer = Attacker;
-		if (CurrentState != EEnemyState::Attack)
+		if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
 		{
-			SetEnemyState(EEnemyState::Chase);
+			AI->AggroOn(this, Attacker);
 		}
 	}
 }
 
+void AEnemyBase::RestoreSavedState(float BodyHealth, EEnemyState SavedState)
+{
+	if (CurrentState == EEnemyState::Dead) return;
+
+	HealthComp->SetBodyPartHealth(EBodyPart::Body, BodyHealth);
+	if (HealthComp->GetHealthPercent(EBodyPart::Body) < 1.f)
+	{
+		ShowHealthBar();
+		UpdateHealthBar();
+	}
+
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
+	{
+		AI->ForceState(this, SavedState == EEnemyState::Patrol ? EEnemyState::Patrol : EEnemyState::Idle);
+	}
+}
+
 // --- Health Bar ---
 
 void AEnemyBase::ShowHealthBar()
@@ -453,6 +283,12 @@ void AEnemyBase::OnEnemyDeath()
 {
 	SetEnemyState(EEnemyState::Dead);
 
+	// Dead is terminal — drop out of the batched AI update.
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
+	{
+		AI->UnregisterEnemy(this);
+	}
+
 	// Disable collisions so the player can walk through the corpse
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	MeleeHitbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -523,5 +359,85 @@ void AEnemyBase::SpawnLoot()
 
 void AEnemyBase::DestroyEnemy()
 {
-	Destroy();
+	if (UEnemyPool* Pool = GetWorld()->GetSubsystem<UEnemyPool>())
+	{
+		Pool->Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+// --- Pooling ---
+
+void AEnemyBase::ResetForReuse()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	HealthComp->ResetHealth();
+
+	// Straight assignment — SetEnemyState won't leave Dead.
+	CurrentState = EEnemyState::Idle;
+	CurrentSpeed = 0.f;
+	CachedPlayer = nullptr;
+
+	bIsAttacking = false;
+	SwingEndTime = 0.0;
+	AttackReadyTime = 0.0;
+	MoveUnlockTime = 0.0;
+	RotationUnlockTime = 0.0;
+	HitActorsThisSwing.Empty();
+	MeleeHitbox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	if (GetMesh() && GetMesh()->GetAnimInstance())
+	{
+		GetMesh()->GetAnimInstance()->StopAllMontages(0.f);
+	}
+
+	// Hidden until first damage hit, as on a fresh spawn.
+	HealthBarComp->SetVisibility(false);
+	UpdateHealthBar();
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->MaxWalkSpeed = PatrolSpeed;
+}
+
+void AEnemyBase::EnterPool()
+{
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
+	{
+		AI->UnregisterEnemy(this);
+	}
+
+	ResetForReuse();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	Mover->SetComponentTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	bInPool = true;
+}
+
+void AEnemyBase::LeavePool(const FVector& Location, const FRotator& Rotation)
+{
+	bInPool = false;
+
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	GetCapsuleComponent()->SetCollisionEnabled(DefaultCapsuleCollision);
+	GetMesh()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetDefaultMovementMode();
+	Mover->SetComponentTickEnabled(Mover->bUseKinematicMover); // Takes character movement's tick back on its first tick.
+
+	// Patrol wanders around the location registered here — the new spawn point.
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
+	{
+		AI->RegisterEnemy(this);
+	}
 }
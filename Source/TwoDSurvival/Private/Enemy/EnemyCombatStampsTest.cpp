@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyBase.h"
+#include "Components/BoxComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// One swing, stepped frame by frame the way UEnemyAIManager's gather runs it. Each state must
+// flip on the first frame at or past the delay its removed timer used:
+//   SwingTimerHandle     → DisableMeleeHitbox      SwingWindowDuration after EnableMeleeHitbox
+//   AttackCooldownTimer  → bIsAttacking / bCanAttack  AttackCooldown
+//   PostAttackMoveTimer  → move unlock             AttackCooldown + PostAttackStandStillDuration
+//   RotationLockTimer    → rotation unlock         AttackRotationLockDuration
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyCombatStampsTest, "TwoDSurvival.Enemy.CombatStamps",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyCombatStampsTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	AEnemyBase* Enemy = World->SpawnActor<AEnemyBase>();
+	if (!TestNotNull(TEXT("Spawned enemy"), Enemy))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	// Not a divisor of any default duration, so no flip lands exactly on a frame boundary.
+	const double Dt = 0.007;
+
+	// AnimNotify_BeginAttack opens the hitbox a little into the montage.
+	const double HitboxDelay = 0.1;
+
+	const double SwingStart = World->GetTimeSeconds();
+	Enemy->BeginMeleeAttack();
+	TestTrue(TEXT("Attacking after BeginMeleeAttack"), Enemy->bIsAttacking);
+
+	double HitboxStart = -1.0;
+	double HitboxClosed = -1.0;
+	double AttackEnded = -1.0;
+	double CanAttack = -1.0;
+	double MoveUnlocked = -1.0;
+	double RotationUnlocked = -1.0;
+
+	const double Horizon = Enemy->AttackCooldown + Enemy->PostAttackStandStillDuration + 1.0;
+	while (World->TimeSeconds - SwingStart < Horizon)
+	{
+		World->TimeSeconds += Dt;
+		const double Now = World->GetTimeSeconds();
+		const double Elapsed = Now - SwingStart;
+
+		Enemy->ExpireCombatStamps(Now);
+
+		if (HitboxStart < 0.0 && Elapsed >= HitboxDelay)
+		{
+			Enemy->EnableMeleeHitbox();
+			HitboxStart = Elapsed;
+		}
+		else if (HitboxStart >= 0.0 && HitboxClosed < 0.0
+			&& Enemy->MeleeHitbox->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+		{
+			HitboxClosed = Elapsed - HitboxStart;
+		}
+
+		if (AttackEnded < 0.0 && !Enemy->bIsAttacking) AttackEnded = Elapsed;
+		if (CanAttack < 0.0 && Enemy->CanAttackAt(Now)) CanAttack = Elapsed;
+		if (MoveUnlocked < 0.0 && !Enemy->IsMoveLockedAt(Now)) MoveUnlocked = Elapsed;
+		if (RotationUnlocked < 0.0 && !Enemy->IsRotationLockedAt(Now)) RotationUnlocked = Elapsed;
+	}
+
+	// A timer with delay Rate, ticked by the same frames, fires on the first frame whose elapsed
+	// time reaches Rate.
+	auto TestFlip = [this, Dt](const TCHAR* What, double Flipped, double Rate)
+	{
+		if (TestTrue(FString::Printf(TEXT("%s flipped"), What), Flipped >= 0.0))
+		{
+			TestTrue(FString::Printf(TEXT("%s not before %.3fs (flipped at %.3fs)"), What, Rate, Flipped),
+				Flipped >= Rate - KINDA_SMALL_NUMBER);
+			TestTrue(FString::Printf(TEXT("%s on the first frame past %.3fs (flipped at %.3fs)"), What, Rate, Flipped),
+				Flipped < Rate + Dt);
+		}
+	};
+
+	TestFlip(TEXT("Hitbox close"), HitboxClosed, Enemy->SwingWindowDuration);
+	TestFlip(TEXT("bIsAttacking clear"), AttackEnded, Enemy->AttackCooldown);
+	TestFlip(TEXT("Can attack"), CanAttack, Enemy->AttackCooldown);
+	TestFlip(TEXT("Move unlock"), MoveUnlocked, Enemy->AttackCooldown + Enemy->PostAttackStandStillDuration);
+	TestFlip(TEXT("Rotation unlock"), RotationUnlocked, Enemy->AttackRotationLockDuration);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyMoverComponent.h"
+#include "World/GroundSpanCache.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+
+UEnemyMoverComponent::UEnemyMoverComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UEnemyMoverComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Character = Cast<ACharacter>(GetOwner());
+	CharacterMovement = Character ? Character->GetCharacterMovement() : nullptr;
+	Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+	Ground = GetWorld()->GetSubsystem<UGroundSpanCache>();
+
+	if (!bUseKinematicMover || !CharacterMovement || !Capsule || !Ground)
+	{
+		bUseKinematicMover = false;
+		return;
+	}
+
+	// Animation reads the velocity the mover writes, same as it would after character movement.
+	if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Mesh->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+	}
+
+	SetComponentTickEnabled(true);
+	TakeOver();
+}
+
+void UEnemyMoverComponent::AddImpulse(const FVector& Impulse)
+{
+	if (!IsDrivingMovement())
+	{
+		if (Character) Character->LaunchCharacter(Impulse, false, false);
+		return;
+	}
+
+	CharacterMovement->Velocity += FVector(Impulse.X, 0.f, Impulse.Z);
+	if (Impulse.Z > 0.f)
+	{
+		SetGrounded(false);
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Hand-over
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UEnemyMoverComponent::NeedsCharacterMovement(const FVector& Location) const
+{
+	if (Character->IsPlayingRootMotion()) return true;
+
+	const float FootZ = Location.Z - Capsule->GetScaledCapsuleHalfHeight();
+	return Ground->Sample(Location.X, Location.Y, FootZ).bInBuilding;
+}
+
+void UEnemyMoverComponent::HandOver()
+{
+	bDeferring = true;
+	bInContact = false;
+	CharacterMovement->SetComponentTickEnabled(true);
+	CharacterMovement->SetMovementMode(bGrounded ? MOVE_Walking : MOVE_Falling);
+}
+
+void UEnemyMoverComponent::TakeOver()
+{
+	bDeferring = false;
+	bInContact = false;
+	bGrounded = !CharacterMovement->IsFalling();
+	CharacterMovement->SetComponentTickEnabled(false);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tick
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyMoverComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// DisableMovement — dead or parked in the pool.
+	if (!bUseKinematicMover || CharacterMovement->MovementMode == MOVE_None) return;
+
+	const FVector Location = Character->GetActorLocation();
+	const bool bSpecial = NeedsCharacterMovement(Location);
+
+	if (bDeferring)
+	{
+		if (!bSpecial && CharacterMovement->IsMovingOnGround())
+		{
+			TakeOver();
+		}
+		else
+		{
+			return;
+		}
+	}
+	else if (bSpecial)
+	{
+		HandOver();
+		return;
+	}
+
+	// Something else (e.g. leaving the pool) turned character movement back on.
+	if (CharacterMovement->IsComponentTickEnabled())
+	{
+		CharacterMovement->SetComponentTickEnabled(false);
+	}
+
+	Step(DeltaTime);
+}
+
+void UEnemyMoverComponent::Step(float DeltaTime)
+{
+	const FVector Location = Character->GetActorLocation();
+	const float HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	const float FootZ = Location.Z - HalfHeight;
+
+	FVector Velocity = CharacterMovement->Velocity;
+	const FVector Input = Character->ConsumeMovementInputVector();
+
+	if (bGrounded)
+	{
+		const float Target = FMath::Clamp(Input.X, -1.f, 1.f) * CharacterMovement->MaxWalkSpeed;
+		const float Rate = FMath::IsNearlyZero(Input.X)
+			? CharacterMovement->BrakingDecelerationWalking
+			: CharacterMovement->GetMaxAcceleration();
+		Velocity.X = FMath::FInterpConstantTo(Velocity.X, Target, DeltaTime, FMath::Max(Rate, 1.f));
+		Velocity.Z = FMath::Max(Velocity.Z, 0.f);
+	}
+	else
+	{
+		Velocity.X = FMath::FInterpConstantTo(Velocity.X, 0.f, DeltaTime, AirDeceleration);
+		Velocity.Z += CharacterMovement->GetGravityZ() * DeltaTime;
+	}
+	Velocity.Y = 0.f;
+
+	FVector NewLocation = Location + Velocity * DeltaTime;
+	NewLocation.Y = Location.Y;
+
+	const float StepHeight = CharacterMovement->MaxStepHeight;
+	const int32 FromBin = Ground->GetBin(Location.X);
+	const int32 ToBin = Ground->GetBin(NewLocation.X);
+
+	// Every bin strictly between here and the destination must be passable too.
+	bool bBlocked = false;
+	const int32 Dir = ToBin >= FromBin ? 1 : -1;
+	for (int32 Bin = FromBin + Dir; Bin * Dir < ToBin * Dir && !bBlocked; Bin += Dir)
+	{
+		const FGroundSample Crossed = Ground->Sample(Ground->GetBinCenter(Bin), Location.Y, FootZ);
+		bBlocked = Crossed.bHit && Crossed.Z > FootZ + StepHeight;
+	}
+
+	const FGroundSample Ahead = Ground->Sample(NewLocation.X, Location.Y, FootZ);
+	bBlocked |= Ahead.bHit && Ahead.Z > FootZ + StepHeight;
+
+	if (bBlocked)
+	{
+		NewLocation.Z = Location.Z;
+	}
+	else if (bGrounded && Velocity.Z <= 0.f)
+	{
+		if (Ahead.bHit && Ahead.Z >= FootZ - StepHeight)
+		{
+			NewLocation.Z = Ahead.Z + HalfHeight;
+			Velocity.Z = 0.f;
+		}
+		else
+		{
+			SetGrounded(false); // Walked off a ledge.
+		}
+	}
+	else if (Ahead.bHit && NewLocation.Z - HalfHeight <= Ahead.Z && Velocity.Z <= 0.f)
+	{
+		NewLocation.Z = Ahead.Z + HalfHeight;
+		Velocity.Z = 0.f;
+		SetGrounded(true);
+	}
+
+	// Samples only see the ground at bin centres; a step over whole bins, or toward a pawn the
+	// cache knows nothing about, lets the sweep catch what lies in between.
+	const bool bSkipsBins = FMath::Abs(ToBin - FromBin) > 1;
+	const bool bNearPawn = NearestPawnGap
+		< Capsule->GetScaledCapsuleRadius() * 2.f + FMath::Abs(NewLocation.X - Location.X) + PawnSweepMargin;
+
+	if (bBlocked || bInContact || bSkipsBins || bNearPawn)
+	{
+		FHitResult Hit;
+		Character->SetActorLocation(NewLocation, true, &Hit);
+		bInContact = Hit.bBlockingHit;
+		if (Hit.bBlockingHit)
+		{
+			Velocity.X = 0.f;
+		}
+	}
+	else
+	{
+		Character->SetActorLocation(NewLocation);
+	}
+
+	CharacterMovement->Velocity = Velocity;
+}
+
+void UEnemyMoverComponent::SetGrounded(bool bInGrounded)
+{
+	if (bGrounded == bInGrounded) return;
+	bGrounded = bInGrounded;
+
+	// Keeps IsFalling() right for the AnimBP.
+	CharacterMovement->SetMovementMode(bGrounded ? MOVE_Walking : MOVE_Falling);
+}
@@ -0,0 +1,253 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyPool.h"
+#include "Enemy/EnemyBase.h"
+#include "World/ActorSpatialIndex.h"
+#include "World/StreetManager.h"
+#include "World/LevelMarkerIndex.h"
+#include "World/WorldEventSpawnPoint.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Subsystem
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UEnemyPool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyPool::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UGameInstance* GI = InWorld.GetGameInstance();
+	if (UStreetManager* SM = GI ? GI->GetSubsystem<UStreetManager>() : nullptr)
+	{
+		StreetChangedHandle = SM->OnStreetChanged.AddUObject(this, &UEnemyPool::OnStreetChanged);
+	}
+}
+
+void UEnemyPool::Deinitialize()
+{
+	UWorld* World = GetWorld();
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	if (UStreetManager* SM = GI ? GI->GetSubsystem<UStreetManager>() : nullptr)
+	{
+		SM->OnStreetChanged.Remove(StreetChangedHandle);
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UEnemyPool::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPool, STATGROUP_Tickables);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Acquire / release
+// ─────────────────────────────────────────────────────────────────────────────
+
+AEnemyBase* UEnemyPool::Acquire(TSubclassOf<AEnemyBase> Class, const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* World = GetWorld();
+	if (!Class || !World) return nullptr;
+
+	FEnemyClassPool& Pool = Pools.FindOrAdd(Class.Get());
+	while (Pool.Free.Num() > 0)
+	{
+		AEnemyBase* Enemy = Pool.Free.Pop(EAllowShrinking::No).Get();
+		if (!IsValid(Enemy)) continue;
+
+		FVector SpawnLocation = Location;
+		FRotator SpawnRotation = Rotation;
+		World->FindTeleportSpot(Enemy, SpawnLocation, SpawnRotation);
+
+		Enemy->LeavePool(SpawnLocation, SpawnRotation);
+		if (UActorSpatialIndex* Index = World->GetSubsystem<UActorSpatialIndex>())
+		{
+			Index->AddActor(Enemy);
+		}
+
+		++Pool.Stats.Reused;
+		return Enemy;
+	}
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AEnemyBase* Enemy = World->SpawnActor<AEnemyBase>(Class, Location, Rotation, Params);
+	if (Enemy)
+	{
+		++Pool.Stats.Spawned;
+	}
+	return Enemy;
+}
+
+void UEnemyPool::Release(AEnemyBase* Enemy)
+{
+	if (!IsValid(Enemy) || Enemy->IsInPool()) return;
+
+	UWorld* World = GetWorld();
+	FEnemyClassPool& Pool = Pools.FindOrAdd(Enemy->GetClass());
+
+	// Level-placed enemies go away with their streamed level, so parking them would leak.
+	const bool bPoolable = World && Enemy->GetLevel() == World->PersistentLevel
+		&& Pool.Free.Num() < MaxPooledPerClass;
+	if (!bPoolable)
+	{
+		++Pool.Stats.Destroyed;
+		Enemy->Destroy();
+		return;
+	}
+
+	Park(Enemy, Pool);
+	++Pool.Stats.Released;
+}
+
+void UEnemyPool::Park(AEnemyBase* Enemy, FEnemyClassPool& Pool)
+{
+	Enemy->EnterPool();
+
+	// Parked enemies must not show up in noise, detection or street capture queries.
+	if (UActorSpatialIndex* Index = GetWorld()->GetSubsystem<UActorSpatialIndex>())
+	{
+		Index->RemoveActor(Enemy);
+	}
+
+	Pool.Free.Add(Enemy);
+}
+
+int32 UEnemyPool::NumFree(TSubclassOf<AEnemyBase> Class) const
+{
+	const FEnemyClassPool* Pool = Class ? Pools.Find(Class.Get()) : nullptr;
+	return Pool ? Pool->Free.Num() : 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Warm-up
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyPool::WarmUp(TSubclassOf<AEnemyBase> Class, int32 Count)
+{
+	if (!Class) return;
+
+	FEnemyClassPool& Pool = Pools.FindOrAdd(Class.Get());
+	Pool.Free.RemoveAll([](const TWeakObjectPtr<AEnemyBase>& Enemy) { return !Enemy.IsValid(); });
+
+	const int32 Target = FMath::Min(Count, MaxPooledPerClass);
+	Pool.PendingWarmUp = FMath::Max(Pool.PendingWarmUp, Target - Pool.Free.Num());
+}
+
+void UEnemyPool::OnStreetChanged()
+{
+	UGameInstance* GI = GetWorld()->GetGameInstance();
+	const UStreetManager* SM = GI ? GI->GetSubsystem<UStreetManager>() : nullptr;
+	const FLevelMarkerIndex* Markers = SM ? SM->GetActiveMarkers() : nullptr;
+	if (!Markers) return;
+
+	for (const TWeakObjectPtr<AWorldEventSpawnPoint>& Point : Markers->WorldEventSpawnPoints)
+	{
+		if (!Point.IsValid()) continue;
+
+		for (const TSubclassOf<AActor>& Class : Point->SpawnPool)
+		{
+			if (Class && Class->IsChildOf<AEnemyBase>())
+			{
+				WarmUp(Class.Get(), WarmUpPerClass);
+			}
+		}
+	}
+}
+
+void UEnemyPool::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	int32 Budget = MaxWarmUpSpawnsPerFrame;
+	for (TPair<TObjectKey<UClass>, FEnemyClassPool>& Entry : Pools)
+	{
+		FEnemyClassPool& Pool = Entry.Value;
+		if (Pool.PendingWarmUp <= 0) continue;
+
+		UClass* Class = Entry.Key.ResolveObjectPtr();
+		if (!Class)
+		{
+			Pool.PendingWarmUp = 0;
+			continue;
+		}
+
+		while (Pool.PendingWarmUp > 0 && Budget > 0)
+		{
+			--Pool.PendingWarmUp;
+			--Budget;
+
+			AEnemyBase* Enemy = World->SpawnActor<AEnemyBase>(Class, WarmUpLocation, FRotator::ZeroRotator, Params);
+			if (!Enemy) continue;
+
+			Park(Enemy, Pool);
+			++Pool.Stats.WarmedUp;
+		}
+
+		if (Budget <= 0) break;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Stats
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UEnemyPool::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("[EnemyPool] %d classes (max %d parked per class)."), Pools.Num(), MaxPooledPerClass);
+
+	for (const TPair<TObjectKey<UClass>, FEnemyClassPool>& Entry : Pools)
+	{
+		const UClass* Class = Entry.Key.ResolveObjectPtr();
+		const FEnemyPoolStats& S = Entry.Value.Stats;
+		const int32 Acquired = S.Spawned + S.Reused;
+
+		Ar.Logf(TEXT("  %-32s free %3d | spawned %5d  reused %5d (%5.1f%%)  warmed %4d | released %5d  destroyed %5d"),
+			Class ? *Class->GetName() : TEXT("<unloaded>"),
+			Entry.Value.Free.Num(), S.Spawned, S.Reused,
+			Acquired > 0 ? 100.0 * S.Reused / Acquired : 0.0,
+			S.WarmedUp, S.Released, S.Destroyed);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/**
+	 * TwoD.EnemyPoolStats
+	 *
+	 * Prints parked counts and spawn/reuse/release counters per enemy class.
+	 */
+	void EnemyPoolStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UEnemyPool* Pool = World ? World->GetSubsystem<UEnemyPool>() : nullptr;
+		if (!Pool)
+		{
+			Ar.Log(TEXT("[EnemyPool] No EnemyPool in this world."));
+			return;
+		}
+
+		Pool->DumpStats(Ar);
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice EnemyPoolStatsCommand(
+		TEXT("TwoD.EnemyPoolStats"),
+		TEXT("Prints per-class enemy pool counts and reuse rate."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&EnemyPoolStats));
+}
+
+#endif // !UE_BUILD_SHIPPING
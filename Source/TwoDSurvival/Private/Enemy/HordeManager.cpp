@@ -0,0 +1,453 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/HordeManager.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyAIManager.h"
+#include "Enemy/EnemyPool.h"
+#include "Character/HealthComponent.h"
+#include "Character/HealthTypes.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	FRotator FacingRotation(int8 Dir)
+	{
+		return FRotator(0.f, Dir < 0 ? 180.f : 0.f, 0.f);
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Subsystem
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UHordeManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHordeManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FActorSpawnParameters Params;
+	Params.ObjectFlags |= RF_Transient;
+	InstanceOwner = InWorld.SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	if (InstanceOwner)
+	{
+		USceneComponent* Root = NewObject<USceneComponent>(InstanceOwner, TEXT("Root"));
+		InstanceOwner->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	WorldOffsetHandle = FWorldDelegates::OnPostWorldOriginOffset.AddUObject(this, &UHordeManager::OnWorldOriginOffset);
+}
+
+void UHordeManager::Deinitialize()
+{
+	FWorldDelegates::OnPostWorldOriginOffset.Remove(WorldOffsetHandle);
+
+	Members.Empty();
+	Promoted.Empty();
+	InstanceOwner = nullptr;
+	ClassInstances.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UHordeManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHordeManager, STATGROUP_Tickables);
+}
+
+void UHordeManager::OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin)
+{
+	if (InWorld != GetWorld()) return;
+
+	const FVector Offset(DstOrigin - SrcOrigin);
+	for (FHordeMember& Member : Members)
+	{
+		Member.Position -= Offset;
+		Member.HomeX    -= Offset.X;
+		Member.AlertX   -= Offset.X;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Class table
+// ─────────────────────────────────────────────────────────────────────────────
+
+uint16 UHordeManager::FindOrAddClass(TSubclassOf<AEnemyBase> Class)
+{
+	const int32 Existing = Classes.IndexOfByKey(Class);
+	if (Existing != INDEX_NONE) return static_cast<uint16>(Existing);
+
+	const AEnemyBase* CDO = Class->GetDefaultObject<AEnemyBase>();
+
+	FHordeClassParams& P = ClassParams.AddDefaulted_GetRef();
+	P.PatrolRange          = CDO->PatrolRange;
+	P.IdleWaitTime         = CDO->IdleWaitTime;
+	P.AlertInvestigateTime = CDO->AlertInvestigateTime;
+	P.PatrolSpeed          = CDO->PatrolSpeed;
+	P.AlertSpeed           = CDO->AlertSpeed;
+
+	UInstancedStaticMeshComponent* Instances = nullptr;
+	if (CDO->HordeProxyMesh && InstanceOwner)
+	{
+		Instances = NewObject<UInstancedStaticMeshComponent>(InstanceOwner);
+		Instances->SetStaticMesh(CDO->HordeProxyMesh);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCanEverAffectNavigation(false);
+		Instances->SetupAttachment(InstanceOwner->GetRootComponent());
+		Instances->RegisterComponent();
+	}
+	ClassInstances.Add(Instances);
+	InstanceScratch.AddDefaulted();
+
+	return static_cast<uint16>(Classes.Add(Class));
+}
+
+UClass* UHordeManager::GetMemberClass(uint16 ClassIndex) const
+{
+	return Classes.IsValidIndex(ClassIndex) ? Classes[ClassIndex].Get() : nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Members
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHordeManager::StageHorde(TSubclassOf<AEnemyBase> Class, const FVector& Center, float Spread, int32 Count)
+{
+	if (!Class || Count <= 0) return;
+
+	const uint16 ClassIndex = FindOrAddClass(Class);
+	const FHordeClassParams& P = ClassParams[ClassIndex];
+	const float Health = Class->GetDefaultObject<AEnemyBase>()->HealthComp->BodyMaxHealth;
+
+	Members.Reserve(Members.Num() + Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		FHordeMember& Member = Members.AddDefaulted_GetRef();
+		Member.Position   = Center + FVector(FMath::FRandRange(-0.5f, 0.5f) * Spread, 0.f, 0.f);
+		Member.HomeX      = Member.Position.X;
+		Member.AlertX     = Member.Position.X;
+		Member.BodyHealth = Health;
+		Member.ClassIndex = ClassIndex;
+		Member.Dir        = FMath::RandBool() ? 1 : -1;
+
+		// Desynchronise the first Idle → Patrol so the horde doesn't set off in step.
+		Member.StateTimer = FMath::FRand() * P.IdleWaitTime;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Horde] Staged %d %s at X=%.0f (%d members total)."),
+		Count, *Class->GetName(), Center.X, Members.Num());
+}
+
+void UHordeManager::AddMembers(TConstArrayView<FHordeMember> InMembers)
+{
+	Members.Append(InMembers.GetData(), InMembers.Num());
+}
+
+void UHordeManager::ExtractSpan(float MinX, float MaxX, TArray<FHordeMember>& Out)
+{
+	// Snapshot first — Demote edits Promoted.
+	TArray<AEnemyBase*> ToDemote;
+	for (const TWeakObjectPtr<AEnemyBase>& Weak : Promoted)
+	{
+		AEnemyBase* Enemy = Weak.Get();
+		if (!Enemy || Enemy->IsInPool() || Enemy->CurrentState == EEnemyState::Dead) continue;
+
+		const float X = Enemy->GetActorLocation().X;
+		if (X >= MinX && X < MaxX)
+			ToDemote.Add(Enemy);
+	}
+	for (AEnemyBase* Enemy : ToDemote)
+	{
+		Demote(Enemy);
+	}
+
+	for (int32 i = Members.Num() - 1; i >= 0; --i)
+	{
+		const float X = Members[i].Position.X;
+		if (X >= MinX && X < MaxX)
+		{
+			Out.Add(Members[i]);
+			Members.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Update
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHordeManager::Tick(float DeltaTime)
+{
+	// Nothing staged yet. Once there is, keep going so emptied instance lists get cleared.
+	if (Classes.Num() == 0) return;
+
+	SimAccumulator += DeltaTime;
+	if (SimAccumulator >= SimInterval)
+	{
+		Simulate(SimAccumulator);
+		SimAccumulator = 0.f;
+	}
+
+	UWorld* World = GetWorld();
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	const APawn* Player = PC ? PC->GetPawn() : nullptr;
+	if (!Player) return;
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+	DemoteFar(PlayerLocation);
+	PromoteNear(PlayerLocation);
+	UpdateInstances(PlayerLocation);
+}
+
+void UHordeManager::Simulate(float DeltaTime)
+{
+	for (FHordeMember& M : Members)
+	{
+		const FHordeClassParams& P = ClassParams[M.ClassIndex];
+
+		switch (M.State)
+		{
+		case EEnemyState::Idle:
+			M.StateTimer += DeltaTime;
+			if (M.StateTimer >= P.IdleWaitTime)
+			{
+				M.State = EEnemyState::Patrol;
+				M.StateTimer = 0.f;
+			}
+			break;
+
+		case EEnemyState::Patrol:
+		{
+			const float XFromHome = M.Position.X - M.HomeX;
+			if (XFromHome >= P.PatrolRange)  M.Dir = -1;
+			if (XFromHome <= -P.PatrolRange) M.Dir = 1;
+			M.Position.X += M.Dir * P.PatrolSpeed * DeltaTime;
+			break;
+		}
+
+		case EEnemyState::Alert:
+		{
+			const float ToAlert = M.AlertX - M.Position.X;
+			if (FMath::Abs(ToAlert) > 50.f)
+			{
+				M.Dir = ToAlert > 0.f ? 1 : -1;
+				M.Position.X += M.Dir * FMath::Min(P.AlertSpeed * DeltaTime, FMath::Abs(ToAlert));
+			}
+			else
+			{
+				M.StateTimer += DeltaTime;
+				if (M.StateTimer >= P.AlertInvestigateTime)
+				{
+					M.State = EEnemyState::Patrol;
+					M.StateTimer = 0.f;
+				}
+			}
+			break;
+		}
+
+		default:
+			M.State = EEnemyState::Idle;
+			M.StateTimer = 0.f;
+			break;
+		}
+	}
+}
+
+void UHordeManager::PromoteNear(const FVector& PlayerLocation)
+{
+	UWorld* World = GetWorld();
+	UEnemyPool* Pool = World->GetSubsystem<UEnemyPool>();
+	UEnemyAIManager* AI = World->GetSubsystem<UEnemyAIManager>();
+
+	int32 Budget = FMath::Min(MaxPromotionsPerFrame, MaxPromoted - Promoted.Num());
+	for (int32 i = Members.Num() - 1; i >= 0 && Budget > 0; --i)
+	{
+		const FHordeMember M = Members[i];
+		if (FMath::Abs(M.Position.X - PlayerLocation.X) > PromoteDistance) continue;
+
+		UClass* Class = GetMemberClass(M.ClassIndex);
+		if (!Class) continue;
+
+		--Budget;
+		AEnemyBase* Enemy = nullptr;
+		if (Pool)
+		{
+			Enemy = Pool->Acquire(Class, M.Position, FacingRotation(M.Dir));
+		}
+		else
+		{
+			FActorSpawnParameters Params;
+			Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+			Enemy = World->SpawnActor<AEnemyBase>(Class, M.Position, FacingRotation(M.Dir), Params);
+		}
+		if (!Enemy) continue;
+
+		Members.RemoveAtSwap(i, 1, EAllowShrinking::No);
+
+		// Health and Idle/Patrol via the street-restore path; Alert re-raised as a noise at AlertX.
+		Enemy->RestoreSavedState(M.BodyHealth, M.State);
+		if (AI)
+		{
+			AI->SetPatrolAnchors(Enemy, M.HomeX, M.AlertX);
+			if (M.State == EEnemyState::Alert)
+			{
+				AI->HearNoise(Enemy, FVector(M.AlertX, M.Position.Y, M.Position.Z));
+			}
+		}
+
+		Promoted.Add(Enemy);
+		++TotalPromotions;
+	}
+}
+
+void UHordeManager::DemoteFar(const FVector& PlayerLocation)
+{
+	for (int32 i = Promoted.Num() - 1; i >= 0; --i)
+	{
+		AEnemyBase* Enemy = Promoted[i].Get();
+
+		// Died (pooled or destroyed) or taken by a street capture — no longer ours.
+		if (!Enemy || Enemy->IsInPool() || Enemy->CurrentState == EEnemyState::Dead)
+		{
+			Promoted.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		const bool bDisengaged = Enemy->CurrentState == EEnemyState::Idle
+			|| Enemy->CurrentState == EEnemyState::Patrol
+			|| Enemy->CurrentState == EEnemyState::Alert;
+		if (bDisengaged && FMath::Abs(Enemy->GetActorLocation().X - PlayerLocation.X) > DemoteDistance)
+		{
+			Demote(Enemy);
+		}
+	}
+}
+
+void UHordeManager::Demote(AEnemyBase* Enemy)
+{
+	FHordeMember& M = Members.AddDefaulted_GetRef();
+	M.Position   = Enemy->GetActorLocation();
+	M.HomeX      = M.Position.X;
+	M.AlertX     = M.Position.X;
+	M.BodyHealth = Enemy->HealthComp->GetBodyPart(EBodyPart::Body).CurrentHealth;
+	M.ClassIndex = FindOrAddClass(Enemy->GetClass());
+	M.Dir        = FMath::Abs(FRotator::NormalizeAxis(Enemy->GetActorRotation().Yaw)) > 90.f ? -1 : 1;
+
+	// Chase and Attack only get here through ExtractSpan — they lose their target like a restore.
+	const EEnemyState State = Enemy->CurrentState;
+	M.State = (State == EEnemyState::Patrol || State == EEnemyState::Alert) ? State : EEnemyState::Idle;
+
+	if (UEnemyAIManager* AI = GetWorld()->GetSubsystem<UEnemyAIManager>())
+	{
+		AI->GetPatrolAnchors(Enemy, M.HomeX, M.AlertX);
+	}
+
+	Promoted.Remove(Enemy);
+	++TotalDemotions;
+
+	if (UEnemyPool* Pool = GetWorld()->GetSubsystem<UEnemyPool>())
+	{
+		Pool->Release(Enemy);
+	}
+	else
+	{
+		Enemy->Destroy();
+	}
+}
+
+void UHordeManager::UpdateInstances(const FVector& PlayerLocation)
+{
+	for (TArray<FTransform>& Transforms : InstanceScratch)
+	{
+		Transforms.Reset();
+	}
+
+	for (const FHordeMember& M : Members)
+	{
+		if (!ClassInstances[M.ClassIndex]) continue;
+		if (FMath::Abs(M.Position.X - PlayerLocation.X) > DrawDistance) continue;
+
+		InstanceScratch[M.ClassIndex].Emplace(FacingRotation(M.Dir), M.Position);
+	}
+
+	for (int32 c = 0; c < ClassInstances.Num(); ++c)
+	{
+		UInstancedStaticMeshComponent* Instances = ClassInstances[c];
+		if (!Instances) continue;
+
+		const TArray<FTransform>& Transforms = InstanceScratch[c];
+		if (Instances->GetInstanceCount() != Transforms.Num())
+		{
+			// Count only changes on promotion, demotion or crossing DrawDistance.
+			Instances->ClearInstances();
+			Instances->AddInstances(Transforms, /*bShouldReturnIndices=*/false, /*bWorldSpace=*/true);
+		}
+		else if (Transforms.Num() > 0)
+		{
+			Instances->BatchUpdateInstancesTransforms(0, Transforms, /*bWorldSpace=*/true,
+				/*bMarkRenderStateDirty=*/true, /*bTeleport=*/true);
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Stats
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UHordeManager::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("[Horde] %d members, %d promoted — %d promotions, %d demotions. Members %.1f KB."),
+		Members.Num(), Promoted.Num(), TotalPromotions, TotalDemotions, Members.GetAllocatedSize() / 1024.0);
+
+	TArray<int32> PerClass;
+	PerClass.SetNumZeroed(Classes.Num());
+	for (const FHordeMember& M : Members)
+	{
+		++PerClass[M.ClassIndex];
+	}
+
+	for (int32 c = 0; c < Classes.Num(); ++c)
+	{
+		Ar.Logf(TEXT("  %-32s members %6d  drawn %5d"),
+			Classes[c] ? *Classes[c]->GetName() : TEXT("<unloaded>"), PerClass[c],
+			ClassInstances[c] ? ClassInstances[c]->GetInstanceCount() : 0);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/**
+	 * TwoD.HordeStats
+	 *
+	 * Prints horde member, promoted and drawn counts.
+	 */
+	void HordeStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UHordeManager* Horde = World ? World->GetSubsystem<UHordeManager>() : nullptr;
+		if (!Horde)
+		{
+			Ar.Log(TEXT("[Horde] No HordeManager in this world."));
+			return;
+		}
+
+		Horde->DumpStats(Ar);
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice HordeStatsCommand(
+		TEXT("TwoD.HordeStats"),
+		TEXT("Prints horde member, promoted and drawn counts per enemy class."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&HordeStats));
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/ScentField.h"
+
+void FScentField::Configure(float InBinWidth, float InChunkWidth, float InLaneHeight)
+{
+	const float NewBinWidth = FMath::Max(InBinWidth, 1.f);
+	const float NewLaneHeight = FMath::Max(InLaneHeight, 1.f);
+	const int32 NewBinsPerChunk = FMath::Max(FMath::CeilToInt(InChunkWidth / NewBinWidth), 1);
+
+	if (NewBinWidth == BinWidth && NewLaneHeight == LaneHeight && NewBinsPerChunk == BinsPerChunk) return;
+
+	BinWidth = NewBinWidth;
+	LaneHeight = NewLaneHeight;
+	BinsPerChunk = NewBinsPerChunk;
+	Reset();
+}
+
+void FScentField::Deposit(const FVector& From, float FromTime, const FVector& To, float ToTime)
+{
+	const int32 Lane = GetLane(To.Z);
+	const int32 FromBin = GetBin(From.X);
+	const int32 ToBin = GetBin(To.X);
+	const int32 Steps = FMath::Abs(ToBin - FromBin);
+	const int32 Dir = ToBin >= FromBin ? 1 : -1;
+
+	FScentChunk* C = nullptr;
+	int32 CurrentChunk = INDEX_NONE;
+
+	for (int32 Step = 0; Step <= Steps; ++Step)
+	{
+		const int32 Bin = FromBin + Step * Dir;
+		const int32 Chunk = GetChunk(Bin);
+		if (!C || Chunk != CurrentChunk)
+		{
+			CurrentChunk = Chunk;
+			C = &Chunks.FindOrAdd(FIntPoint(Chunk, Lane));
+			if (C->Times.Num() == 0)
+			{
+				C->Times.Init(-1.f, BinsPerChunk);
+			}
+		}
+
+		const float Time = Steps > 0 ? FMath::Lerp(FromTime, ToTime, (float)Step / Steps) : ToTime;
+		float& BinTime = C->Times[Bin - Chunk * BinsPerChunk];
+		BinTime = FMath::Max(BinTime, Time);
+		C->Newest = FMath::Max(C->Newest, Time);
+	}
+}
+
+void FScentField::Prune(float OlderThan)
+{
+	for (auto It = Chunks.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Newest < OlderThan)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+float FScentField::GetBinTime(int32 Bin, int32 Lane) const
+{
+	const int32 Chunk = GetChunk(Bin);
+	const FScentChunk* C = Chunks.Find(FIntPoint(Chunk, Lane));
+	return C ? C->Times[Bin - Chunk * BinsPerChunk] : -1.f;
+}
+
+float FScentField::GetStrength(float Time, float Now, float HalfLife)
+{
+	if (Time < 0.f) return 0.f;
+	return FMath::Exp2(-FMath::Max(Now - Time, 0.f) / FMath::Max(HalfLife, KINDA_SMALL_NUMBER));
+}
+
+float FScentField::Sample(const FVector& Pos, float Now, float HalfLife) const
+{
+	return GetStrength(GetBinTime(GetBin(Pos.X), GetLane(Pos.Z)), Now, HalfLife);
+}
+
+int32 FScentField::GetUphillDir(const FVector& Pos, float Now, float HalfLife, float& OutStrength) const
+{
+	const int32 Bin = GetBin(Pos.X);
+	const int32 Lane = GetLane(Pos.Z);
+
+	const float Here = GetBinTime(Bin, Lane);
+	const float Left = GetBinTime(Bin - 1, Lane);
+	const float Right = GetBinTime(Bin + 1, Lane);
+
+	const float Freshest = FMath::Max3(Here, Left, Right);
+	OutStrength = GetStrength(Freshest, Now, HalfLife);
+	if (Freshest <= Here) return 0;
+	return Right >= Left ? 1 : -1;
+}
+
+void FScentField::Reset()
+{
+	Chunks.Reset();
+}
+
+SIZE_T FScentField::GetAllocatedSize() const
+{
+	SIZE_T Size = Chunks.GetAllocatedSize();
+	for (const TPair<FIntPoint, FScentChunk>& Pair : Chunks)
+	{
+		Size += Pair.Value.Times.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -33,6 +33,24 @@ void UBreakableComponent::ApplyDamage(float Amount, ABaseCharacter* DamageSource
 		OnHealthDepleted();
 }
 
+void UBreakableComponent::RestoreBroken()
+{
+	bIsBroken = true;
+	CurrentHealth = 0.f;
+
+	if (bDestroyOnDeath)
+	{
+		GetOwner()->Destroy();
+		return;
+	}
+
+	if (BrokenMesh)
+	{
+		if (UStaticMeshComponent* SM = GetOwner()->FindComponentByClass<UStaticMeshComponent>())
+			SM->SetStaticMesh(BrokenMesh);
+	}
+}
+
 FText UBreakableComponent::GetPrompt() const
 {
 	FString Name = ActionLabel.IsEmpty() ? TEXT("Object") : ActionLabel.ToString();
@@ -37,60 +37,59 @@ void UMapWidget::BuildMap()
 	const TSet<FName>& Visited  = SM->GetVisitedStreets();
 	const FName        CurrentID = SM->CurrentStreet ? SM->CurrentStreet->StreetID : NAME_None;
 
+	const FStreetGraph& Graph     = SM->GetStreetGraph();
+	const int32         StartNode = SM->GetStreetIndex(Start);
+	if (StartNode == INDEX_NONE || StartNode >= Graph.NumNodes()) return;
+
 	// ── BFS: assign a grid column (float) to every reachable street ──────────
-	TMap<FName, float>            GridX;    // StreetID → column
-	TMap<FName, UStreetDefinition*> AllDefs; // StreetID → definition
-	TQueue<UStreetDefinition*>    Queue;
+	// Works on street graph node indices; Order doubles as the BFS queue.
+	TArray<float> GridX;           // node → column
+	TBitArray<>   Placed(false, Graph.NumNodes());
+	TArray<int32> Order;           // placed nodes in BFS order
+	GridX.SetNumZeroed(Graph.NumNodes());
 
-	GridX.Add(Start->StreetID, 0.f);
-	AllDefs.Add(Start->StreetID, Start);
-	Queue.Enqueue(Start);
+	Placed[StartNode] = true;
+	Order.Add(StartNode);
 
 	// Track how many streets have already been placed at each integer column so that
 	// multiple exits from the same street in the same direction get a small fractional
 	// offset (e.g. 0, +0.6, +1.2 ...) instead of stacking on top of each other.
 	TMap<int32, int32> ColumnOccupancy; // integer column → count already placed there
 
-	while (!Queue.IsEmpty())
+	for (int32 Head = 0; Head < Order.Num(); ++Head)
 	{
-		UStreetDefinition* Street;
-		Queue.Dequeue(Street);
-		const float X = GridX[Street->StreetID];
+		const int32 Node = Order[Head];
+		const float X    = GridX[Node];
 
-		for (const FStreetExitLink& Exit : Street->Exits)
+		for (const FStreetGraphEdge& Edge : Graph.GetEdges(Node))
 		{
-			UStreetDefinition* DestDef = SM->ResolveExitDestination(Street, Exit.ExitID);
-			if (!DestDef) continue;
+			// Buildings are labels on their parent node, not separate map nodes.
+			if (Edge.Layout == EExitLayout::Building) continue;
+			if (Placed[Edge.To]) continue;
 
-			if (Exit.Layout == EExitLayout::Building)
-			{
-				// Buildings are labels on their parent node, not separate map nodes.
-				AllDefs.FindOrAdd(DestDef->StreetID, DestDef);
-				continue;
-			}
-			if (GridX.Contains(DestDef->StreetID)) continue;
-
-			const float Dir    = (Exit.Layout == EExitLayout::AdjacentRight) ? 1.f : -1.f;
+			const float Dir    = (Edge.Layout == EExitLayout::AdjacentRight) ? 1.f : -1.f;
 			const int32 IntCol = FMath::RoundToInt(X + Dir);
 			int32& Count       = ColumnOccupancy.FindOrAdd(IntCol);
 			// Spread multiple streets at the same integer column by 0.6 increments.
 			const float NextX  = IntCol + Count * Dir * 0.6f;
 			++Count;
 
-			GridX.Add(DestDef->StreetID, NextX);
-			AllDefs.Add(DestDef->StreetID, DestDef);
-			Queue.Enqueue(DestDef);
+			GridX[Edge.To]  = NextX;
+			Placed[Edge.To] = true;
+			Order.Add(Edge.To);
 		}
 	}
 
 	// ── Pre-compute canvas positions (needed before creating any widgets) ────
-	TMap<FName, FVector2D> NodeTopLeft; // StreetID → canvas top-left of the node box
+	TArray<FVector2D> NodeTopLeft; // node → canvas top-left of the node box
+	NodeTopLeft.SetNumZeroed(Graph.NumNodes());
+	NodeCenters.SetNumZeroed(Graph.NumNodes());
 
-	for (auto& KV : GridX)
+	for (int32 Node : Order)
 	{
-		const float CanvasX = CanvasOriginX + KV.Value * CellWidth - NodeWidth * 0.5f;
-		NodeTopLeft.Add(KV.Key, FVector2D(CanvasX, CanvasOriginY));
-		NodeCenters.Add(KV.Key, FVector2D(CanvasX + NodeWidth * 0.5f, CanvasOriginY + NodeHeight * 0.5f));
+		const float CanvasX = CanvasOriginX + GridX[Node] * CellWidth - NodeWidth * 0.5f;
+		NodeTopLeft[Node] = FVector2D(CanvasX, CanvasOriginY);
+		NodeCenters[Node] = FVector2D(CanvasX + NodeWidth * 0.5f, CanvasOriginY + NodeHeight * 0.5f);
 	}
 
 	// ── Compute city bounding boxes ──────────────────────────────────────────
@@ -98,17 +97,17 @@ void UMapWidget::BuildMap()
 	struct FCityBounds { UCityDefinition* Def = nullptr; float MinX = MAX_FLT, MaxX = -MAX_FLT; };
 	TMap<FName, FCityBounds> CityAccum;
 
-	for (auto& KV : GridX)
+	for (int32 Node : Order)
 	{
-		UStreetDefinition** DefPtr = AllDefs.Find(KV.Key);
-		if (!DefPtr || !*DefPtr) continue;
-		UCityDefinition* City = (*DefPtr)->OwnerCity.Get();
-		if (!City || (*DefPtr)->bIsHighway || (*DefPtr)->bIsPCGBuilding) continue;
+		UStreetDefinition* Def = SM->GetStreetByIndex(Node);
+		if (!Def) continue;
+		UCityDefinition* City = Def->OwnerCity.Get();
+		if (!City || Def->bIsHighway || Def->bIsPCGBuilding) continue;
 
 		FCityBounds& B = CityAccum.FindOrAdd(City->CityID);
 		B.Def  = City;
-		B.MinX = FMath::Min(B.MinX, NodeTopLeft[KV.Key].X);
-		B.MaxX = FMath::Max(B.MaxX, NodeTopLeft[KV.Key].X + NodeWidth);
+		B.MinX = FMath::Min(B.MinX, NodeTopLeft[Node].X);
+		B.MaxX = FMath::Max(B.MaxX, NodeTopLeft[Node].X + NodeWidth);
 	}
 
 	// ── Create city backgrounds FIRST so they render behind street nodes ─────
@@ -132,34 +131,35 @@ void UMapWidget::BuildMap()
 	}
 
 	// ── Create street node widgets ────────────────────────────────────────────
-	for (auto& KV : GridX)
+	for (int32 Node : Order)
 	{
-		UStreetDefinition** DefPtr = AllDefs.Find(KV.Key);
-		if (!DefPtr || !*DefPtr) continue;
-		if ((*DefPtr)->bIsPCGBuilding) continue; // buildings are labels only
+		UStreetDefinition* Def = SM->GetStreetByIndex(Node);
+		if (!Def) continue;
+		if (Def->bIsPCGBuilding) continue; // buildings are labels only
 
-		const bool bVisited   = Visited.Contains(KV.Key);
-		const bool bIsCurrent = (KV.Key == CurrentID);
+		const bool bVisited   = Visited.Contains(Def->StreetID);
+		const bool bIsCurrent = (Def->StreetID == CurrentID);
 
-		CreateNode(*DefPtr, NodeTopLeft[KV.Key], bVisited, bIsCurrent);
+		CreateNode(Def, NodeTopLeft[Node], bVisited, bIsCurrent);
 	}
 
 	// ── Build connection line pairs ───────────────────────────────────────────
-	for (auto& KV : GridX)
+	for (int32 Node : Order)
 	{
-		UStreetDefinition** DefPtr = AllDefs.Find(KV.Key);
-		if (!DefPtr || !*DefPtr) continue;
+		UStreetDefinition* Def = SM->GetStreetByIndex(Node);
+		if (!Def) continue;
 
-		for (const FStreetExitLink& Exit : (*DefPtr)->Exits)
+		for (const FStreetGraphEdge& Edge : Graph.GetEdges(Node))
 		{
-			if (Exit.Layout != EExitLayout::AdjacentRight) continue;
-			UStreetDefinition* DestDef = SM->ResolveExitDestination(*DefPtr, Exit.ExitID);
+			if (Edge.Layout != EExitLayout::AdjacentRight) continue;
+			if (!Placed[Edge.To]) continue;
+
+			UStreetDefinition* DestDef = SM->GetStreetByIndex(Edge.To);
 			if (!DestDef) continue;
-			if (!NodeCenters.Contains(KV.Key) || !NodeCenters.Contains(DestDef->StreetID)) continue;
 
-			const bool bHwy = (*DefPtr)->bIsHighway || DestDef->bIsHighway;
+			const bool bHwy = Def->bIsHighway || DestDef->bIsHighway;
 			auto& Lines = bHwy ? HighwayLines : ConnectionLines;
-			Lines.Add({ NodeCenters[KV.Key], NodeCenters[DestDef->StreetID] });
+			Lines.Add({ NodeCenters[Node], NodeCenters[Edge.To] });
 		}
 	}
 }
@@ -0,0 +1,268 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/ActorSpatialIndex.h"
+#include "Enemy/EnemyBase.h"
+#include "World/WorldItem.h"
+#include "Interaction/InteractableInterface.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Subsystem
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UActorSpatialIndex::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UActorSpatialIndex::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		AddActor(*It);
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &UActorSpatialIndex::AddActor));
+	ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateUObject(this, &UActorSpatialIndex::RemoveActor));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UActorSpatialIndex::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UActorSpatialIndex::OnLevelRemoved);
+	WorldOffsetHandle = FWorldDelegates::OnPostWorldOriginOffset.AddUObject(this, &UActorSpatialIndex::OnWorldOriginOffset);
+}
+
+void UActorSpatialIndex::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnPostWorldOriginOffset.Remove(WorldOffsetHandle);
+
+	for (TMap<int32, FActorIndexCell>& CategoryCells : Cells)
+	{
+		CategoryCells.Empty();
+	}
+	Entries.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UActorSpatialIndex::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UActorSpatialIndex, STATGROUP_Tickables);
+}
+
+void UActorSpatialIndex::Tick(float DeltaTime)
+{
+	Refresh(EActorIndexCategory::Enemy);
+
+	StaticRefreshTimer += DeltaTime;
+	if (StaticRefreshTimer < StaticRefreshInterval) return;
+	StaticRefreshTimer = 0.f;
+
+	Refresh(EActorIndexCategory::Item);
+	Refresh(EActorIndexCategory::Interactable);
+
+	// Actors that went away without a destroy notification (e.g. garbage-collected with
+	// their level) were already dropped from the cells by Refresh.
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr()) It.RemoveCurrent();
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Queries
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UActorSpatialIndex::QueryRange(EActorIndexCategory Category, float MinX, float MaxX, TArray<AActor*>& Out) const
+{
+	ForEachInRange(Category, MinX, MaxX, [&Out](AActor* Actor) { Out.Add(Actor); });
+}
+
+int32 UActorSpatialIndex::Num(EActorIndexCategory Category) const
+{
+	int32 Count = 0;
+	for (const TPair<int32, FActorIndexCell>& Pair : Cells[(int32)Category])
+	{
+		Count += Pair.Value.Xs.Num();
+	}
+	return Count;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Membership
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UActorSpatialIndex::AddActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || Entries.Contains(Actor)) return;
+
+	bool bMatches[(int32)EActorIndexCategory::Num];
+	bMatches[(int32)EActorIndexCategory::Enemy]        = Actor->IsA<AEnemyBase>();
+	bMatches[(int32)EActorIndexCategory::Item]         = Actor->IsA<AWorldItem>();
+	bMatches[(int32)EActorIndexCategory::Interactable] = Actor->GetClass()->ImplementsInterface(UInteractable::StaticClass());
+
+	FEntry Entry;
+	bool bAny = false;
+	const float X = Actor->GetActorLocation().X;
+	for (int32 c = 0; c < (int32)EActorIndexCategory::Num; ++c)
+	{
+		Entry.Cell[c] = INDEX_NONE;
+		if (!bMatches[c]) continue;
+
+		Entry.Cell[c] = GetCellIndex(X);
+		InsertSorted(Cells[c].FindOrAdd(Entry.Cell[c]), X, Actor);
+		bAny = true;
+	}
+
+	if (bAny)
+	{
+		Entries.Add(Actor, Entry);
+	}
+}
+
+void UActorSpatialIndex::RemoveActor(AActor* Actor)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Actor, Entry)) return;
+
+	const TObjectKey<AActor> Key(Actor);
+	for (int32 c = 0; c < (int32)EActorIndexCategory::Num; ++c)
+	{
+		FActorIndexCell* Cell = Entry.Cell[c] != INDEX_NONE ? Cells[c].Find(Entry.Cell[c]) : nullptr;
+		if (!Cell) continue;
+
+		const int32 Index = Cell->Actors.IndexOfByKey(Key);
+		if (Index == INDEX_NONE) continue;
+
+		Cell->Xs.RemoveAt(Index, 1, EAllowShrinking::No);
+		Cell->Actors.RemoveAt(Index, 1, EAllowShrinking::No);
+		if (Cell->Xs.Num() == 0)
+		{
+			Cells[c].Remove(Entry.Cell[c]);
+		}
+	}
+}
+
+void UActorSpatialIndex::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetWorld()) return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		AddActor(Actor);
+	}
+}
+
+void UActorSpatialIndex::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetWorld()) return;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor) RemoveActor(Actor);
+	}
+}
+
+void UActorSpatialIndex::OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin)
+{
+	if (InWorld != GetWorld()) return;
+
+	// Every actor just moved by the offset — far past any query padding. UStreetManager
+	// captures the street it hides right after rebasing, so re-key all categories now rather
+	// than waiting for the next tick.
+	for (int32 c = 0; c < (int32)EActorIndexCategory::Num; ++c)
+	{
+		Refresh((EActorIndexCategory)c);
+	}
+	StaticRefreshTimer = 0.f;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Sorting
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UActorSpatialIndex::InsertSorted(FActorIndexCell& Cell, float X, AActor* Actor)
+{
+	const int32 Index = Algo::UpperBound(Cell.Xs, X);
+	Cell.Xs.Insert(X, Index);
+	Cell.Actors.Insert(Actor, Index);
+}
+
+void UActorSpatialIndex::Refresh(EActorIndexCategory Category)
+{
+	TMap<int32, FActorIndexCell>& CategoryCells = Cells[(int32)Category];
+
+	TArray<TPair<AActor*, float>, TInlineAllocator<16>> Moved;
+	TArray<int32, TInlineAllocator<4>> EmptyCells;
+
+	for (TPair<int32, FActorIndexCell>& Pair : CategoryCells)
+	{
+		FActorIndexCell& Cell = Pair.Value;
+		TArray<float>& Xs = Cell.Xs;
+		TArray<TObjectKey<AActor>>& Actors = Cell.Actors;
+
+		// Re-key in place; pull out dead actors and actors that crossed into another cell.
+		for (int32 i = Xs.Num() - 1; i >= 0; --i)
+		{
+			AActor* Actor = Actors[i].ResolveObjectPtr();
+			const float X = Actor ? Actor->GetActorLocation().X : 0.f;
+			if (Actor && GetCellIndex(X) == Pair.Key)
+			{
+				Xs[i] = X;
+				continue;
+			}
+
+			if (Actor) Moved.Emplace(Actor, X);
+			Xs.RemoveAt(i, 1, EAllowShrinking::No);
+			Actors.RemoveAt(i, 1, EAllowShrinking::No);
+		}
+
+		// Insertion sort — actors move a few cm per frame, so almost nothing shifts.
+		for (int32 i = 1; i < Xs.Num(); ++i)
+		{
+			const float X = Xs[i];
+			if (Xs[i - 1] <= X) continue;
+
+			const TObjectKey<AActor> Actor = Actors[i];
+			int32 j = i;
+			for (; j > 0 && Xs[j - 1] > X; --j)
+			{
+				Xs[j] = Xs[j - 1];
+				Actors[j] = Actors[j - 1];
+			}
+			Xs[j] = X;
+			Actors[j] = Actor;
+		}
+
+		if (Xs.Num() == 0)
+		{
+			EmptyCells.Add(Pair.Key);
+		}
+	}
+
+	for (const TPair<AActor*, float>& Move : Moved)
+	{
+		const int32 NewCell = GetCellIndex(Move.Value);
+		InsertSorted(CategoryCells.FindOrAdd(NewCell), Move.Value, Move.Key);
+		EmptyCells.Remove(NewCell);
+		if (FEntry* Entry = Entries.Find(Move.Key))
+		{
+			Entry->Cell[(int32)Category] = NewCell;
+		}
+	}
+
+	for (int32 CellIndex : EmptyCells)
+	{
+		CategoryCells.Remove(CellIndex);
+	}
+}
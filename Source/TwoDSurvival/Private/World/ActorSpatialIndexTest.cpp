@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/ActorSpatialIndex.h"
+#include "World/WorldItem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// UStreetManager rebases the world origin and captures the street it hides in the same frame,
+// so queries straight after SetNewWorldOrigin must already see the shifted positions.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorSpatialIndexRebaseTest, "TwoDSurvival.World.ActorSpatialIndex.Rebase",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FActorSpatialIndexRebaseTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	UActorSpatialIndex* Index = World->GetSubsystem<UActorSpatialIndex>();
+	if (!TestNotNull(TEXT("Spatial index"), Index))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	// Two items on the far street the origin moves onto, one on the street left behind.
+	const float Rebase = 500000.f;
+	AWorldItem* Near = World->SpawnActor<AWorldItem>(FVector(Rebase + 100.f, 0.f, 0.f), FRotator::ZeroRotator);
+	AWorldItem* Far = World->SpawnActor<AWorldItem>(FVector(Rebase + 3000.f, 0.f, 0.f), FRotator::ZeroRotator);
+	AWorldItem* Behind = World->SpawnActor<AWorldItem>(FVector(100.f, 0.f, 0.f), FRotator::ZeroRotator);
+
+	auto Query = [Index](float MinX, float MaxX)
+	{
+		TArray<AActor*> Found;
+		Index->QueryRange(EActorIndexCategory::Item, MinX, MaxX, Found);
+		return Found;
+	};
+
+	TestEqual(TEXT("Before rebase: street items found at city X"), Query(Rebase, Rebase + 4000.f).Num(), 2);
+
+	// No tick in between — the rebase alone must re-key the index.
+	TestTrue(TEXT("Origin rebased"), World->SetNewWorldOrigin(FIntVector((int32)Rebase, 0, 0)));
+
+	const TArray<AActor*> NearHits = Query(0.f, 200.f);
+	TestTrue(TEXT("After rebase: near item found at its new X"), NearHits.Num() == 1 && NearHits[0] == Near);
+
+	const TArray<AActor*> FarHits = Query(2900.f, 3100.f);
+	TestTrue(TEXT("After rebase: far item found at its new X"), FarHits.Num() == 1 && FarHits[0] == Far);
+
+	const TArray<AActor*> BehindHits = Query(-Rebase, -Rebase + 200.f);
+	TestTrue(TEXT("After rebase: item left behind found at its new X"), BehindHits.Num() == 1 && BehindHits[0] == Behind);
+
+	TestEqual(TEXT("After rebase: nothing left at the old city X"), Query(Rebase, Rebase + 4000.f).Num(), 0);
+	TestEqual(TEXT("After rebase: every item still indexed once"), Index->Num(EActorIndexCategory::Item), 3);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
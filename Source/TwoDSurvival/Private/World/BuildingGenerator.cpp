@@ -7,9 +7,12 @@
 #include "World/VerticalTransport.h"
 #include "World/BuildingInteriorVolume.h"
 #include "World/BuildingFacadePanel.h"
+#include "World/DoorActor.h"
+#include "World/OcclusionSpanCache.h"
 #include "Components/BoxComponent.h"
 #include "Engine/World.h"
 #include "Math/RandomStream.h"
+#include "EngineUtils.h"
 
 ABuildingGenerator::ABuildingGenerator()
 {
@@ -39,6 +42,10 @@ void ABuildingGenerator::Generate()
 
 	const UBuildingDefinition* Def = BuildingDef;
 
+	RoomGraph.Reset();
+	RoomGraph.FloorCount    = Def->FloorCount;
+	RoomGraph.RoomsPerFloor = Def->RoomsPerFloor;
+
 	const int32 Seed = (Def->RandomSeed != 0) ? Def->RandomSeed : FMath::Rand();
 	FRandomStream Stream(Seed);
 
@@ -76,6 +83,23 @@ void ABuildingGenerator::Generate()
 			}
 		}
 
+		// --- Vertical links to the floor above ---
+		if (!bTopFloor)
+		{
+			for (int32 Room = 0; Room < Def->RoomsPerFloor; Room++)
+			{
+				const bool bStairs = StairRooms.Contains(Room) && Def->StairsActorClass;
+				const bool bElev   = Def->bHasElevator && Def->ElevatorRoomActorClass &&
+				                     FMath::IsNearlyEqual(Room * Def->RoomWidth, Def->ElevatorX, 1.f);
+
+				FRoomLink& Link = RoomGraph.Links.AddDefaulted_GetRef();
+				Link.A    = RoomGraph.GetNode(Floor, Room);
+				Link.B    = RoomGraph.GetNode(Floor + 1, Room);
+				Link.Kind = (bStairs || bElev) ? ERoomLinkKind::Stairs : ERoomLinkKind::Slab;
+				Link.Cost = bStairs ? Def->StairsTraversalCost : bElev ? Def->ElevatorTraversalCost : 0.f;
+			}
+		}
+
 		// --- Spawn rooms ---
 		for (int32 Room = 0; Room < Def->RoomsPerFloor; Room++)
 		{
@@ -167,6 +191,14 @@ void ABuildingGenerator::Generate()
 		}
 	}
 
+	BuildRoomLinks();
+
+	// Walls, slabs and doors all moved — enemy line of sight is rebuilt on its next query.
+	if (UOcclusionSpanCache* Occlusion = GetWorld()->GetSubsystem<UOcclusionSpanCache>())
+	{
+		Occlusion->Invalidate();
+	}
+
 	const float TotalWidth  = Def->RoomsPerFloor * Def->RoomWidth;
 	const float TotalHeight = Def->FloorCount * Def->FloorHeight;
 
@@ -216,6 +248,104 @@ void ABuildingGenerator::Generate()
 		SpawnedActors.Num(), *GetName(), Def->FloorCount, Def->RoomsPerFloor, Seed);
 }
 
+int32 ABuildingGenerator::GetFloorAt(const FVector& WorldPos) const
+{
+	if (!BuildingDef || BuildingDef->FloorHeight <= 0.f) return INDEX_NONE;
+
+	const FVector Local = GetActorRotation().UnrotateVector(WorldPos - GetActorLocation());
+	if (Local.X < 0.f || Local.X >= BuildingDef->RoomsPerFloor * BuildingDef->RoomWidth) return INDEX_NONE;
+
+	const int32 Floor = FMath::FloorToInt(Local.Z / BuildingDef->FloorHeight);
+	return (Floor >= 0 && Floor < BuildingDef->FloorCount) ? Floor : INDEX_NONE;
+}
+
+int32 ABuildingGenerator::GetRoomAt(const FVector& WorldPos) const
+{
+	const int32 Floor = GetFloorAt(WorldPos);
+	if (Floor == INDEX_NONE || RoomGraph.RoomsPerFloor == 0) return INDEX_NONE;
+
+	const FVector Local = GetActorRotation().UnrotateVector(WorldPos - GetActorLocation());
+	const int32 Room = FMath::Clamp(FMath::FloorToInt(Local.X / BuildingDef->RoomWidth), 0, RoomGraph.RoomsPerFloor - 1);
+	return RoomGraph.GetNode(Floor, Room);
+}
+
+bool ABuildingGenerator::FindRoomPath(const FVector& From, const FVector& To, TArray<int32>& OutNodes) const
+{
+	const int32 FromNode = GetRoomAt(From);
+	const int32 ToNode   = GetRoomAt(To);
+	return RoomGraph.FindPath(
+		FromNode != INDEX_NONE ? FromNode : RoomGraph.GetOutsideNode(),
+		ToNode != INDEX_NONE ? ToNode : RoomGraph.GetOutsideNode(),
+		OutNodes);
+}
+
+FVector ABuildingGenerator::GetRoomLocation(int32 Node) const
+{
+	if (!BuildingDef || Node < 0 || Node >= RoomGraph.GetOutsideNode()) return GetActorLocation();
+
+	const int32 Floor = Node / RoomGraph.RoomsPerFloor;
+	const int32 Room  = Node % RoomGraph.RoomsPerFloor;
+	const FVector Local((Room + 0.5f) * BuildingDef->RoomWidth, 0.f, Floor * BuildingDef->FloorHeight);
+	return GetActorLocation() + GetActorRotation().RotateVector(Local);
+}
+
+void ABuildingGenerator::BuildRoomLinks()
+{
+	const UBuildingDefinition* Def = BuildingDef;
+	const int32 Rooms = Def->RoomsPerFloor;
+
+	// Doors on a wall between two slots (or on the outer wall of the ground floor), keyed by
+	// (floor, wall index) where wall W separates slot W-1 from slot W. Spawned room props and
+	// doors placed by hand in the sublevel both count.
+	TMap<FIntPoint, ADoorActor*> WallDoors;
+	for (TActorIterator<ADoorActor> It(GetWorld()); It; ++It)
+	{
+		const int32 Floor = GetFloorAt(It->GetActorLocation());
+		const FVector Local = GetActorRotation().UnrotateVector(It->GetActorLocation() - GetActorLocation());
+		const int32 Wall = FMath::RoundToInt(Local.X / Def->RoomWidth);
+		if (Wall < 0 || Wall > Rooms) continue;
+		if (FMath::Abs(Local.X - Wall * Def->RoomWidth) > Def->RoomWidth * 0.25f) continue;
+
+		// Outer-wall doors sit just outside the footprint, so GetFloorAt misses them.
+		const int32 DoorFloor = Floor != INDEX_NONE ? Floor : FMath::FloorToInt(Local.Z / Def->FloorHeight);
+		if (DoorFloor < 0 || DoorFloor >= Def->FloorCount) continue;
+
+		WallDoors.Add(FIntPoint(DoorFloor, Wall), *It);
+	}
+
+	auto AddLink = [this, &WallDoors](int32 A, int32 B, int32 Floor, int32 Wall, float Cost)
+	{
+		FRoomLink& Link = RoomGraph.Links.AddDefaulted_GetRef();
+		Link.A = A;
+		Link.B = B;
+		Link.Cost = Cost;
+		if (ADoorActor* const* Door = WallDoors.Find(FIntPoint(Floor, Wall)))
+		{
+			Link.Kind = ERoomLinkKind::Door;
+			Link.Door = *Door;
+		}
+	};
+
+	for (int32 Floor = 0; Floor < Def->FloorCount; Floor++)
+	{
+		for (int32 Wall = 1; Wall < Rooms; Wall++)
+		{
+			AddLink(RoomGraph.GetNode(Floor, Wall - 1), RoomGraph.GetNode(Floor, Wall), Floor, Wall, Def->RoomWidth);
+		}
+	}
+
+	// Ground-floor entrances — leftmost and rightmost slots open onto the street, half a room
+	// from the middle of the end room.
+	if (Rooms > 0 && Def->FloorCount > 0)
+	{
+		AddLink(RoomGraph.GetNode(0, 0), RoomGraph.GetOutsideNode(), 0, 0, Def->RoomWidth * 0.5f);
+		if (Rooms > 1)
+			AddLink(RoomGraph.GetNode(0, Rooms - 1), RoomGraph.GetOutsideNode(), 0, Rooms, Def->RoomWidth * 0.5f);
+	}
+
+	RoomGraph.BuildAdjacency();
+}
+
 AActor* ABuildingGenerator::SpawnRoomAt(TSubclassOf<AActor> ActorClass, FVector WorldPosition)
 {
 	FActorSpawnParameters Params;
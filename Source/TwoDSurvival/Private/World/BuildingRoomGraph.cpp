@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/BuildingRoomGraph.h"
+#include "World/DoorActor.h"
+#include "Algo/Reverse.h"
+
+void FBuildingRoomGraph::Reset()
+{
+	FloorCount = 0;
+	RoomsPerFloor = 0;
+	Links.Empty();
+	AdjacencyOffsets.Empty();
+	AdjacencyLinks.Empty();
+	MinHorizontalCost = 0.f;
+	MinVerticalCost = 0.f;
+	MinEntranceCost = 0.f;
+	LinkOpen.Empty();
+	++DoorStateVersion;
+	Transmission.Empty();
+	TransmissionVersion = INDEX_NONE;
+	CachedClosedDoorFactor = -1.f;
+	CachedSlabFactor = -1.f;
+	PathCache.Empty();
+	PathCacheVersion = INDEX_NONE;
+}
+
+void FBuildingRoomGraph::BuildAdjacency()
+{
+	const int32 N = NumNodes();
+	AdjacencyOffsets.Init(0, N + 1);
+	for (const FRoomLink& Link : Links)
+	{
+		++AdjacencyOffsets[Link.A + 1];
+		++AdjacencyOffsets[Link.B + 1];
+	}
+	for (int32 i = 0; i < N; ++i)
+	{
+		AdjacencyOffsets[i + 1] += AdjacencyOffsets[i];
+	}
+
+	TArray<int32> Fill(AdjacencyOffsets.GetData(), N);
+	AdjacencyLinks.SetNumUninitialized(AdjacencyOffsets[N]);
+
+	const int32 Outside = GetOutsideNode();
+	MinHorizontalCost = MinVerticalCost = MinEntranceCost = TNumericLimits<float>::Max();
+	for (int32 i = 0; i < Links.Num(); ++i)
+	{
+		const FRoomLink& Link = Links[i];
+		AdjacencyLinks[Fill[Link.A]++] = i;
+		AdjacencyLinks[Fill[Link.B]++] = i;
+
+		if (Link.Kind == ERoomLinkKind::Slab) continue;
+		float& Min = (Link.A == Outside || Link.B == Outside) ? MinEntranceCost
+			: Link.Kind == ERoomLinkKind::Stairs ? MinVerticalCost
+			: MinHorizontalCost;
+		Min = FMath::Min(Min, Link.Cost);
+	}
+
+	// A kind with no links never bounds a path.
+	for (float* Min : { &MinHorizontalCost, &MinVerticalCost, &MinEntranceCost })
+	{
+		if (*Min == TNumericLimits<float>::Max()) *Min = 0.f;
+	}
+
+	PathCache.Reset();
+	PathCacheVersion = INDEX_NONE;
+}
+
+void FBuildingRoomGraph::RefreshDoorStates() const
+{
+	bool bChanged = LinkOpen.Num() != Links.Num();
+	LinkOpen.SetNum(Links.Num());
+
+	for (int32 i = 0; i < Links.Num(); ++i)
+	{
+		const FRoomLink& Link = Links[i];
+		bool bOpen = Link.Kind != ERoomLinkKind::Slab;
+		if (Link.Kind == ERoomLinkKind::Door)
+		{
+			// A door destroyed with its room no longer blocks anything.
+			const ADoorActor* Door = Link.Door.Get();
+			bOpen = !Door || Door->IsOpen();
+		}
+
+		if (LinkOpen[i] != bOpen)
+		{
+			LinkOpen[i] = bOpen;
+			bChanged = true;
+		}
+	}
+
+	if (bChanged)
+	{
+		++DoorStateVersion;
+	}
+}
+
+float FBuildingRoomGraph::GetNoiseTransmission(int32 From, int32 To, float ClosedDoorFactor, float SlabFactor) const
+{
+	const int32 N = NumNodes();
+	if (From < 0 || From >= N || To < 0 || To >= N) return 1.f;
+	if (From == To) return 1.f;
+
+	RefreshDoorStates();
+	if (TransmissionVersion != DoorStateVersion || Transmission.Num() != N * N
+		|| ClosedDoorFactor != CachedClosedDoorFactor || SlabFactor != CachedSlabFactor)
+	{
+		RebuildTransmission(ClosedDoorFactor, SlabFactor);
+	}
+	return Transmission[From * N + To];
+}
+
+void FBuildingRoomGraph::RebuildTransmission(float ClosedDoorFactor, float SlabFactor) const
+{
+	const int32 N = NumNodes();
+	Transmission.Init(0.f, N * N);
+	TransmissionVersion = DoorStateVersion;
+	CachedClosedDoorFactor = ClosedDoorFactor;
+	CachedSlabFactor = SlabFactor;
+
+	for (int32 i = 0; i < N; ++i)
+	{
+		Transmission[i * N + i] = 1.f;
+	}
+
+	for (int32 LinkIndex = 0; LinkIndex < Links.Num(); ++LinkIndex)
+	{
+		const FRoomLink& Link = Links[LinkIndex];
+		float Factor = 1.f;
+		switch (Link.Kind)
+		{
+		case ERoomLinkKind::Door:
+			Factor = LinkOpen[LinkIndex] ? 1.f : ClosedDoorFactor;
+			break;
+		case ERoomLinkKind::Slab:
+			Factor = SlabFactor;
+			break;
+		default:
+			break;
+		}
+
+		float& AB = Transmission[Link.A * N + Link.B];
+		float& BA = Transmission[Link.B * N + Link.A];
+		AB = BA = FMath::Max(AB, Factor);
+	}
+
+	// Floyd–Warshall on max-product: the loudest path wins. N is rooms + 1, so this is tiny.
+	for (int32 k = 0; k < N; ++k)
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			const float IK = Transmission[i * N + k];
+			if (IK <= 0.f) continue;
+			for (int32 j = 0; j < N; ++j)
+			{
+				float& IJ = Transmission[i * N + j];
+				IJ = FMath::Max(IJ, IK * Transmission[k * N + j]);
+			}
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Paths
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool FBuildingRoomGraph::FindPath(int32 From, int32 To, TArray<int32>& OutNodes, float* OutCost) const
+{
+	OutNodes.Reset();
+	const int32 N = NumNodes();
+	if (From < 0 || From >= N || To < 0 || To >= N) return false;
+
+	const FRoomPath& Path = GetCachedPath(From, To);
+	if (Path.Cost < 0.f) return false;
+
+	OutNodes = Path.Nodes;
+	if (OutCost) *OutCost = Path.Cost;
+	return true;
+}
+
+int32 FBuildingRoomGraph::GetNextHop(int32 From, int32 To) const
+{
+	const int32 N = NumNodes();
+	if (From < 0 || From >= N || To < 0 || To >= N) return INDEX_NONE;
+	if (From == To) return From;
+
+	const FRoomPath& Path = GetCachedPath(From, To);
+	return Path.Cost < 0.f ? INDEX_NONE : Path.Nodes[1];
+}
+
+const FRoomLink* FBuildingRoomGraph::FindLink(int32 A, int32 B) const
+{
+	if (!AdjacencyOffsets.IsValidIndex(A + 1)) return nullptr;
+
+	for (int32 e = AdjacencyOffsets[A]; e < AdjacencyOffsets[A + 1]; ++e)
+	{
+		const FRoomLink& Link = Links[AdjacencyLinks[e]];
+		if (Link.A == B || Link.B == B) return &Link;
+	}
+	return nullptr;
+}
+
+const FRoomPath& FBuildingRoomGraph::GetCachedPath(int32 From, int32 To) const
+{
+	RefreshDoorStates();
+	if (PathCacheVersion != DoorStateVersion)
+	{
+		PathCache.Reset();
+		PathCacheVersion = DoorStateVersion;
+	}
+
+	const int32 Key = From * NumNodes() + To;
+	if (const FRoomPath* Cached = PathCache.Find(Key))
+	{
+		return *Cached;
+	}
+	return PathCache.Add(Key, SearchPath(From, To));
+}
+
+float FBuildingRoomGraph::EstimateCost(int32 From, int32 To) const
+{
+	if (From == To) return 0.f;
+
+	const int32 Outside = GetOutsideNode();
+	if (From == Outside || To == Outside)
+	{
+		const int32 Inside = From == Outside ? To : From;
+		return (Inside / RoomsPerFloor) * MinVerticalCost + MinEntranceCost;
+	}
+
+	const int32 FloorA = From / RoomsPerFloor, RoomA = From % RoomsPerFloor;
+	const int32 FloorB = To / RoomsPerFloor,   RoomB = To % RoomsPerFloor;
+
+	// Rooms only change slot along a floor, unless the path leaves through one entrance and
+	// comes back in through the other — which means going down to the ground floor and back.
+	const float Direct = FMath::Abs(FloorA - FloorB) * MinVerticalCost + FMath::Abs(RoomA - RoomB) * MinHorizontalCost;
+	const float ViaOutside = (FloorA + FloorB) * MinVerticalCost + 2.f * MinEntranceCost;
+	return FMath::Min(Direct, ViaOutside);
+}
+
+FRoomPath FBuildingRoomGraph::SearchPath(int32 From, int32 To) const
+{
+	FRoomPath Result;
+	const int32 N = NumNodes();
+	if (AdjacencyOffsets.Num() != N + 1) return Result;
+
+	TArray<float, TInlineAllocator<64>> Costs;
+	TArray<int32, TInlineAllocator<64>> Parents;
+	TArray<bool, TInlineAllocator<64>> Closed;
+	Costs.Init(TNumericLimits<float>::Max(), N);
+	Parents.Init(INDEX_NONE, N);
+	Closed.Init(false, N);
+
+	struct FOpenNode
+	{
+		int32 Node;
+		float Estimate;
+	};
+	auto ByEstimate = [](const FOpenNode& A, const FOpenNode& B) { return A.Estimate < B.Estimate; };
+
+	TArray<FOpenNode, TInlineAllocator<32>> Open;
+	Costs[From] = 0.f;
+	Open.HeapPush({ From, EstimateCost(From, To) }, ByEstimate);
+
+	while (Open.Num() > 0)
+	{
+		FOpenNode Top;
+		Open.HeapPop(Top, ByEstimate, EAllowShrinking::No);
+		if (Top.Node == To) break;
+		if (Closed[Top.Node]) continue;
+		Closed[Top.Node] = true;
+
+		for (int32 e = AdjacencyOffsets[Top.Node]; e < AdjacencyOffsets[Top.Node + 1]; ++e)
+		{
+			const int32 LinkIndex = AdjacencyLinks[e];
+			if (!LinkOpen[LinkIndex]) continue;
+
+			const FRoomLink& Link = Links[LinkIndex];
+			const int32 Next = Link.A == Top.Node ? Link.B : Link.A;
+			const float Cost = Costs[Top.Node] + Link.Cost;
+			if (Cost < Costs[Next])
+			{
+				Costs[Next] = Cost;
+				Parents[Next] = Top.Node;
+				Open.HeapPush({ Next, Cost + EstimateCost(Next, To) }, ByEstimate);
+			}
+		}
+	}
+
+	if (Costs[To] == TNumericLimits<float>::Max()) return Result;
+
+	for (int32 Node = To; Node != INDEX_NONE; Node = Parents[Node])
+	{
+		Result.Nodes.Add(Node);
+	}
+	Algo::Reverse(Result.Nodes);
+	Result.Cost = Costs[To];
+	return Result;
+}
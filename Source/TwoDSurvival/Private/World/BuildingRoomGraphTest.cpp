@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/BuildingRoomGraph.h"
+#include "World/DoorActor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Two floors of three rooms, stairs at both ends, a door between ground rooms 1 and 2:
+//
+//   floor 1   [3] ── [4] ── [5]
+//              ‖      ▒      ‖        ‖ stairs, ▒ slab
+//   floor 0   [0] ── [1] ┆┆ [2]       ┆┆ door
+//              │
+//           outside
+//
+// With the door closed the only way from 1 to 2 is up one staircase and down the other.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBuildingRoomGraphPathTest, "TwoDSurvival.World.BuildingRoomGraph.Path",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBuildingRoomGraphPathTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	ADoorActor* Door = World->SpawnActor<ADoorActor>();
+	if (!TestNotNull(TEXT("Spawned door"), Door))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+	Door->SetOpen(false);
+
+	const float RoomCost = 800.f;
+	const float StairsCost = 1200.f;
+
+	FBuildingRoomGraph Graph;
+	Graph.FloorCount = 2;
+	Graph.RoomsPerFloor = 3;
+
+	auto AddLink = [&Graph](int32 A, int32 B, ERoomLinkKind Kind, float Cost, ADoorActor* LinkDoor = nullptr)
+	{
+		FRoomLink& Link = Graph.Links.AddDefaulted_GetRef();
+		Link.A = A;
+		Link.B = B;
+		Link.Kind = Kind;
+		Link.Cost = Cost;
+		Link.Door = LinkDoor;
+	};
+	AddLink(0, 1, ERoomLinkKind::Open, RoomCost);
+	AddLink(1, 2, ERoomLinkKind::Door, RoomCost, Door);
+	AddLink(3, 4, ERoomLinkKind::Open, RoomCost);
+	AddLink(4, 5, ERoomLinkKind::Open, RoomCost);
+	AddLink(0, 3, ERoomLinkKind::Stairs, StairsCost);
+	AddLink(1, 4, ERoomLinkKind::Slab, 0.f);
+	AddLink(2, 5, ERoomLinkKind::Stairs, StairsCost);
+	AddLink(Graph.GetOutsideNode(), 0, ERoomLinkKind::Open, RoomCost * 0.5f);
+	Graph.BuildAdjacency();
+
+	TArray<int32> Path;
+	float Cost = -1.f;
+
+	// Door closed — around through the upper floor.
+	TestTrue(TEXT("Closed door: reachable"), Graph.FindPath(1, 2, Path, &Cost));
+	TestTrue(TEXT("Closed door: up the left stairs, down the right"), Path == TArray<int32>({ 1, 0, 3, 4, 5, 2 }));
+	TestEqual(TEXT("Closed door: cost"), Cost, RoomCost * 3.f + StairsCost * 2.f);
+	TestEqual(TEXT("Closed door: next hop"), Graph.GetNextHop(1, 2), 0);
+	TestEqual(TEXT("Closed door: next hop from the stairs room is upstairs"), Graph.GetNextHop(0, 2), 3);
+
+	// The slab under room 4 is never walkable, even though it is the shortest hop.
+	TestTrue(TEXT("Slab: reachable"), Graph.FindPath(1, 4, Path, &Cost));
+	TestTrue(TEXT("Slab: by the stairs"), Path == TArray<int32>({ 1, 0, 3, 4 }));
+
+	// From the street in through the entrance and up.
+	TestTrue(TEXT("Outside: reachable"), Graph.FindPath(Graph.GetOutsideNode(), 5, Path, &Cost));
+	TestTrue(TEXT("Outside: in and up"), Path == TArray<int32>({ Graph.GetOutsideNode(), 0, 3, 4, 5 }));
+
+	// Opening the door invalidates the cached answers.
+	Door->SetOpen(true);
+	TestTrue(TEXT("Open door: reachable"), Graph.FindPath(1, 2, Path, &Cost));
+	TestTrue(TEXT("Open door: straight through"), Path == TArray<int32>({ 1, 2 }));
+	TestEqual(TEXT("Open door: cost"), Cost, RoomCost);
+	TestEqual(TEXT("Open door: next hop"), Graph.GetNextHop(1, 2), 2);
+	TestEqual(TEXT("Already there"), Graph.GetNextHop(2, 2), 2);
+
+	// Closing it again with the right stairs cut off leaves room 2 unreachable.
+	Door->SetOpen(false);
+	Graph.Links[6].Kind = ERoomLinkKind::Slab;
+	Graph.BuildAdjacency();
+	TestFalse(TEXT("Shut in: unreachable"), Graph.FindPath(1, 2, Path));
+	TestEqual(TEXT("Shut in: no path"), Path.Num(), 0);
+	TestEqual(TEXT("Shut in: no next hop"), Graph.GetNextHop(1, 2), (int32)INDEX_NONE);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
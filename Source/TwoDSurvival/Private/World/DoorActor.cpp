@@ -4,6 +4,8 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/NoiseEmitterComponent.h"
+#include "World/OcclusionSpanCache.h"
+#include "World/GroundSpanCache.h"
 #include "Kismet/GameplayStatics.h"
 
 ADoorActor::ADoorActor()
@@ -62,6 +64,12 @@ void ADoorActor::OnInteract_Implementation(ABaseCharacter* Interactor)
 	UNoiseEmitterComponent::BroadcastNoiseAt(GetWorld(), GetActorLocation(), 500.f);
 }
 
+void ADoorActor::SetOpen(bool bOpen)
+{
+	bIsOpen = bOpen;
+	ApplyOpenState();
+}
+
 // ── Helpers ───────────────────────────────────────────────────────────────────
 
 void ADoorActor::ApplyOpenState()
@@ -69,4 +77,17 @@ void ADoorActor::ApplyOpenState()
 	DoorMesh->SetVisibility(!bIsOpen);
 	DoorMesh->SetCollisionEnabled(bIsOpen ? ECollisionEnabled::NoCollision
 	                                       : ECollisionEnabled::QueryAndPhysics);
+
+	// Enemies see through the doorway only while it is open.
+	if (UOcclusionSpanCache* Occlusion = GetWorld() ? GetWorld()->GetSubsystem<UOcclusionSpanCache>() : nullptr)
+	{
+		Occlusion->OnDoorChanged(this);
+	}
+
+	// Enemy movers read the panel from the ground cache — re-trace the bins it covers.
+	if (UGroundSpanCache* Ground = GetWorld() ? GetWorld()->GetSubsystem<UGroundSpanCache>() : nullptr)
+	{
+		const FBox Box = DoorMesh->Bounds.GetBox();
+		Ground->InvalidateRange(Box.Min.X, Box.Max.X);
+	}
 }
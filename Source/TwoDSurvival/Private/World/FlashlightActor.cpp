@@ -50,12 +50,22 @@ void AFlashlightActor::RefillBattery(float Amount)
 
 bool AFlashlightActor::IsInCone(FVector WorldPos) const
 {
-	if (!bIsLightOn || !SpotLight) return false;
+	FVector Origin, LightFwd;
+	float CosHalfAngle;
+	if (!GetCone(Origin, LightFwd, CosHalfAngle)) return false;
 
-	const FVector ToTarget    = (WorldPos - GetActorLocation()).GetSafeNormal();
-	const FVector LightFwd    = SpotLight->GetForwardVector();
+	const FVector ToTarget    = (WorldPos - Origin).GetSafeNormal();
 	const float   Dot         = FVector::DotProduct(LightFwd, ToTarget);
-	const float   HalfAngle   = FMath::DegreesToRadians(SpotLight->OuterConeAngle);
 
-	return Dot >= FMath::Cos(HalfAngle);
+	return Dot >= CosHalfAngle;
+}
+
+bool AFlashlightActor::GetCone(FVector& OutOrigin, FVector& OutForward, float& OutCosHalfAngle) const
+{
+	if (!bIsLightOn || !SpotLight) return false;
+
+	OutOrigin       = GetActorLocation();
+	OutForward      = SpotLight->GetForwardVector();
+	OutCosHalfAngle = FMath::Cos(FMath::DegreesToRadians(SpotLight->OuterConeAngle));
+	return true;
 }
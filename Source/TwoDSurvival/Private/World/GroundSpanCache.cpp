@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/GroundSpanCache.h"
+#include "World/BuildingGenerator.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Subsystem
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UGroundSpanCache::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGroundSpanCache::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UGroundSpanCache::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UGroundSpanCache::OnLevelChanged);
+	WorldOffsetHandle = FWorldDelegates::OnPostWorldOriginOffset.AddUObject(this, &UGroundSpanCache::OnWorldOriginOffset);
+}
+
+void UGroundSpanCache::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnPostWorldOriginOffset.Remove(WorldOffsetHandle);
+	Invalidate();
+
+	Super::Deinitialize();
+}
+
+void UGroundSpanCache::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		Invalidate();
+	}
+}
+
+void UGroundSpanCache::OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin)
+{
+	if (InWorld == GetWorld())
+	{
+		Invalidate();
+	}
+}
+
+void UGroundSpanCache::Invalidate()
+{
+	Samples.Reset();
+	Buildings.Reset();
+	bBuildingsDirty = true;
+}
+
+void UGroundSpanCache::InvalidateRange(float MinX, float MaxX)
+{
+	const int32 FirstBin = GetBin(MinX);
+	const int32 LastBin = GetBin(MaxX);
+	for (auto It = Samples.CreateIterator(); It; ++It)
+	{
+		const int32 Bin = (int32)(It.Key() >> 32);
+		if (Bin >= FirstBin && Bin <= LastBin)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Sampling
+// ─────────────────────────────────────────────────────────────────────────────
+
+FGroundSample UGroundSpanCache::Sample(float X, float Y, float FootZ)
+{
+	const int32 Bin = GetBin(X);
+	const int32 Band = FMath::FloorToInt(FootZ / HeightBand);
+	const int64 Key = ((int64)Bin << 32) | (uint32)Band;
+
+	if (const FGroundSample* Cached = Samples.Find(Key))
+	{
+		return *Cached;
+	}
+	return Samples.Add(Key, Trace(Bin, Band, Y));
+}
+
+FGroundSample UGroundSpanCache::Trace(int32 Bin, int32 Band, float Y)
+{
+	UWorld* World = GetWorld();
+
+	if (bBuildingsDirty)
+	{
+		bBuildingsDirty = false;
+		for (TActorIterator<ABuildingGenerator> It(World); It; ++It)
+		{
+			Buildings.Add(*It);
+		}
+	}
+
+	const float X = GetBinCenter(Bin);
+	const float BandBottom = Band * HeightBand;
+	const FVector Start(X, Y, BandBottom + HeightBand + ProbeUp);
+	const FVector End(X, Y, BandBottom - ProbeDown);
+
+	FGroundSample Result;
+
+	FHitResult Hit;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(GroundSpanCache), false);
+	if (World->LineTraceSingleByObjectType(Hit, Start, End, FCollisionObjectQueryParams(ECC_WorldStatic), Params))
+	{
+		Result.bHit = true;
+		Result.Z = Hit.ImpactPoint.Z;
+	}
+
+	const FVector Probe(X, Y, BandBottom + HeightBand * 0.5f);
+	for (const TWeakObjectPtr<ABuildingGenerator>& Building : Buildings)
+	{
+		if (Building.IsValid() && Building->GetFloorAt(Probe) != INDEX_NONE)
+		{
+			Result.bInBuilding = true;
+			break;
+		}
+	}
+
+	return Result;
+}
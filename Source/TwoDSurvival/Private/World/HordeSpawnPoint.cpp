@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/HordeSpawnPoint.h"
+#include "World/StreetManager.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/HordeManager.h"
+#include "Engine/GameInstance.h"
+
+#if WITH_EDITOR
+#include "Components/ArrowComponent.h"
+#endif
+
+AHordeSpawnPoint::AHordeSpawnPoint()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	USceneComponent* Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent = Root;
+
+#if WITH_EDITORONLY_DATA
+	// Red arrow — distinct from the orange AWorldEventSpawnPoint arrows.
+	EditorArrow = CreateEditorOnlyDefaultSubobject<UArrowComponent>(TEXT("EditorArrow"));
+	if (EditorArrow)
+	{
+		EditorArrow->SetupAttachment(RootComponent);
+		EditorArrow->ArrowColor          = FColor(200, 30, 30);
+		EditorArrow->ArrowSize           = 2.f;
+		EditorArrow->bIsScreenSizeScaled = true;
+		EditorArrow->SetHiddenInGame(true);
+	}
+#endif
+}
+
+void AHordeSpawnPoint::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!EnemyClass) return;
+
+	// Street was visited before — FStreetStateStore hands its saved horde back instead.
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UStreetManager* SM = GI->GetSubsystem<UStreetManager>())
+		{
+			if (SM->ShouldSuppressLevelSpawns(GetLevel())) return;
+		}
+	}
+
+	if (UHordeManager* Horde = GetWorld()->GetSubsystem<UHordeManager>())
+	{
+		Horde->StageHorde(EnemyClass, GetActorLocation(), Spread, Count);
+	}
+}
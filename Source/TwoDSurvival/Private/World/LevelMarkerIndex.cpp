@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/LevelMarkerIndex.h"
+#include "World/ExitSpawnPoint.h"
+#include "World/WorldEventSpawnPoint.h"
+#include "World/BuildingEntrance.h"
+#include "Engine/Level.h"
+
+FLevelMarkerIndex FLevelMarkerIndex::Build(const ULevel* Level)
+{
+	FLevelMarkerIndex Index;
+	if (!Level) return Index;
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!Actor) continue;
+
+		if (AExitSpawnPoint* Spawn = Cast<AExitSpawnPoint>(Actor))
+		{
+			if (!Spawn->SpawnID.IsNone() && !Index.ExitSpawnPoints.Contains(Spawn->SpawnID))
+				Index.ExitSpawnPoints.Add(Spawn->SpawnID, Spawn);
+		}
+		else if (AWorldEventSpawnPoint* EventPoint = Cast<AWorldEventSpawnPoint>(Actor))
+		{
+			Index.WorldEventSpawnPoints.Add(EventPoint);
+			if (!EventPoint->SpawnPointID.IsNone() && !Index.WorldEventSpawnPointsByID.Contains(EventPoint->SpawnPointID))
+				Index.WorldEventSpawnPointsByID.Add(EventPoint->SpawnPointID, EventPoint);
+		}
+		else if (ABuildingEntrance* Entrance = Cast<ABuildingEntrance>(Actor))
+		{
+			Index.BuildingEntrances.Add(Entrance);
+		}
+	}
+
+	return Index;
+}
+
+AExitSpawnPoint* FLevelMarkerIndex::FindExitSpawnPoint(FName SpawnID) const
+{
+	const TWeakObjectPtr<AExitSpawnPoint>* Found = ExitSpawnPoints.Find(SpawnID);
+	return Found ? Found->Get() : nullptr;
+}
+
+AWorldEventSpawnPoint* FLevelMarkerIndex::FindWorldEventSpawnPoint(FName SpawnPointID) const
+{
+	const TWeakObjectPtr<AWorldEventSpawnPoint>* Found = WorldEventSpawnPointsByID.Find(SpawnPointID);
+	return Found ? Found->Get() : nullptr;
+}
+
+ABuildingEntrance* FLevelMarkerIndex::GetFirstBuildingEntrance() const
+{
+	for (const TWeakObjectPtr<ABuildingEntrance>& Entrance : BuildingEntrances)
+	{
+		if (ABuildingEntrance* E = Entrance.Get())
+			return E;
+	}
+	return nullptr;
+}
@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/OcclusionSpanCache.h"
+#include "World/BuildingGenerator.h"
+#include "World/BuildingDefinition.h"
+#include "World/DoorActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FOcclusionSpans
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FOcclusionSpans::Reset(float InCellWidth)
+{
+	CellWidth = FMath::Max(InCellWidth, 1.f);
+	Spans.Reset();
+	Cells.Reset();
+}
+
+int32 FOcclusionSpans::Add(float MinX, float MaxX, float MinZ, float MaxZ)
+{
+	const int32 Index = Spans.Add({ MinX, MaxX, MinZ, MaxZ, true });
+
+	const int32 LastCell = GetCell(MaxX);
+	for (int32 Cell = GetCell(MinX); Cell <= LastCell; ++Cell)
+	{
+		Cells.FindOrAdd(Cell).Add(Index);
+	}
+	return Index;
+}
+
+void FOcclusionSpans::Finalize()
+{
+	for (TPair<int32, TArray<int32>>& Pair : Cells)
+	{
+		Pair.Value.Sort([this](int32 A, int32 B) { return Spans[A].MinX < Spans[B].MinX; });
+	}
+}
+
+bool FOcclusionSpans::SegmentHitsSpan(const FVector2D& A, const FVector2D& B, const FOcclusionSpan& Span)
+{
+	// Slab clipping of the segment against the rectangle, one axis at a time.
+	const FVector2D D = B - A;
+	const float Mins[2] = { Span.MinX, Span.MinZ };
+	const float Maxs[2] = { Span.MaxX, Span.MaxZ };
+
+	float T0 = 0.f;
+	float T1 = 1.f;
+	for (int32 Axis = 0; Axis < 2; ++Axis)
+	{
+		if (FMath::IsNearlyZero(D[Axis]))
+		{
+			if (A[Axis] < Mins[Axis] || A[Axis] > Maxs[Axis]) return false;
+			continue;
+		}
+
+		float Enter = (Mins[Axis] - A[Axis]) / D[Axis];
+		float Exit = (Maxs[Axis] - A[Axis]) / D[Axis];
+		if (Enter > Exit) Swap(Enter, Exit);
+
+		T0 = FMath::Max(T0, Enter);
+		T1 = FMath::Min(T1, Exit);
+		if (T0 > T1) return false;
+	}
+	return true;
+}
+
+bool FOcclusionSpans::IsVisible(const FVector& From, const FVector& To) const
+{
+	const FVector2D A(From.X, From.Z);
+	const FVector2D B(To.X, To.Z);
+	const float MinX = FMath::Min(A.X, B.X);
+	const float MaxX = FMath::Max(A.X, B.X);
+
+	const int32 LastCell = GetCell(MaxX);
+	for (int32 Cell = GetCell(MinX); Cell <= LastCell; ++Cell)
+	{
+		const TArray<int32>* Indices = Cells.Find(Cell);
+		if (!Indices) continue;
+
+		for (int32 Index : *Indices)
+		{
+			const FOcclusionSpan& Span = Spans[Index];
+			if (Span.MinX > MaxX) break;
+			if (Span.MaxX < MinX || !Span.bBlocking) continue;
+
+			if (SegmentHitsSpan(A, B, Span)) return false;
+		}
+	}
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Subsystem
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool UOcclusionSpanCache::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UOcclusionSpanCache::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UOcclusionSpanCache::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UOcclusionSpanCache::OnLevelChanged);
+	WorldOffsetHandle = FWorldDelegates::OnPostWorldOriginOffset.AddUObject(this, &UOcclusionSpanCache::OnWorldOriginOffset);
+	bDirty = true;
+}
+
+void UOcclusionSpanCache::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnPostWorldOriginOffset.Remove(WorldOffsetHandle);
+	Spans.Reset(CellWidth);
+	DoorSpans.Empty();
+
+	Super::Deinitialize();
+}
+
+void UOcclusionSpanCache::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		bDirty = true;
+	}
+}
+
+void UOcclusionSpanCache::OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin)
+{
+	if (InWorld == GetWorld())
+	{
+		bDirty = true;
+	}
+}
+
+void UOcclusionSpanCache::OnDoorChanged(ADoorActor* Door)
+{
+	if (bDirty || !Door) return;
+
+	if (const int32* Index = DoorSpans.Find(Door))
+	{
+		Spans.SetBlocking(*Index, !Door->IsOpen());
+	}
+	else
+	{
+		bDirty = true;
+	}
+}
+
+const FOcclusionSpans& UOcclusionSpanCache::GetSpans()
+{
+	if (bDirty)
+	{
+		bDirty = false;
+		Rebuild();
+	}
+	return Spans;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rebuild
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UOcclusionSpanCache::Rebuild()
+{
+	UWorld* World = GetWorld();
+	Spans.Reset(CellWidth);
+	DoorSpans.Reset();
+
+	for (TActorIterator<ABuildingGenerator> It(World); It; ++It)
+	{
+		const ABuildingGenerator* Building = *It;
+		const UBuildingDefinition* Def = Building->BuildingDef;
+		const FBuildingRoomGraph& Graph = Building->GetRoomGraph();
+		if (!Def || Graph.FloorCount == 0 || Graph.RoomsPerFloor == 0) continue;
+
+		const FVector Origin = Building->GetActorLocation();
+		const FRotator Rotation = Building->GetActorRotation();
+
+		// Buildings only yaw, so a local X/Z rectangle stays one in world space.
+		auto AddLocal = [this, &Origin, &Rotation](float MinX, float MaxX, float MinZ, float MaxZ)
+		{
+			const FVector A = Origin + Rotation.RotateVector(FVector(MinX, 0.f, MinZ));
+			const FVector B = Origin + Rotation.RotateVector(FVector(MaxX, 0.f, MaxZ));
+			Spans.Add(FMath::Min(A.X, B.X), FMath::Max(A.X, B.X), FMath::Min(A.Z, B.Z), FMath::Max(A.Z, B.Z));
+		};
+
+		const float Width = Graph.RoomsPerFloor * Def->RoomWidth;
+		const float HalfWall = WallThickness * 0.5f;
+		const float HalfSlab = SlabThickness * 0.5f;
+
+		for (int32 Floor = 0; Floor < Graph.FloorCount; ++Floor)
+		{
+			const float FloorZ = Floor * Def->FloorHeight;
+			const float CeilingZ = FloorZ + Def->FloorHeight;
+
+			// Outer walls. Ground-floor entrance slots are open to the street — a door on them
+			// gets its own span below.
+			if (Floor > 0 || !Def->LeftEntranceActorClass)
+			{
+				AddLocal(-HalfWall, HalfWall, FloorZ, CeilingZ);
+			}
+			if (Floor > 0 || !Def->RightEntranceActorClass)
+			{
+				AddLocal(Width - HalfWall, Width + HalfWall, FloorZ, CeilingZ);
+			}
+
+			// Ceiling slab (the roof on the top floor), merged across rooms, open over stairs.
+			int32 RunStart = INDEX_NONE;
+			for (int32 Room = 0; Room <= Graph.RoomsPerFloor; ++Room)
+			{
+				bool bSolid = false;
+				if (Room < Graph.RoomsPerFloor)
+				{
+					const FRoomLink* Link = Floor + 1 < Graph.FloorCount
+						? Graph.FindLink(Graph.GetNode(Floor, Room), Graph.GetNode(Floor + 1, Room))
+						: nullptr;
+					bSolid = !Link || Link->Kind != ERoomLinkKind::Stairs;
+				}
+
+				if (bSolid && RunStart == INDEX_NONE)
+				{
+					RunStart = Room;
+				}
+				else if (!bSolid && RunStart != INDEX_NONE)
+				{
+					AddLocal(RunStart * Def->RoomWidth, Room * Def->RoomWidth, CeilingZ - HalfSlab, CeilingZ + HalfSlab);
+					RunStart = INDEX_NONE;
+				}
+			}
+		}
+	}
+
+	for (TActorIterator<ADoorActor> It(World); It; ++It)
+	{
+		ADoorActor* Door = *It;
+		if (!Door->DoorMesh || !Door->DoorMesh->GetStaticMesh()) continue;
+
+		const FBox Box = Door->DoorMesh->Bounds.GetBox();
+		const int32 Index = Spans.Add(Box.Min.X, Box.Max.X, Box.Min.Z, Box.Max.Z);
+		Spans.SetBlocking(Index, !Door->IsOpen());
+		DoorSpans.Add(Door, Index);
+	}
+
+	Spans.Finalize();
+}
@@ -44,7 +44,7 @@ void AStreetExit::OnTriggerOverlap(UPrimitiveComponent* OverlappedComponent, AAc
 	{
 		if (UStreetManager* SM = GI->GetSubsystem<UStreetManager>())
 		{
-			SM->OnPlayerCrossedExit(ExitID);
+			SM->OnPlayerCrossedExit(ExitID, GetLevel());
 		}
 	}
 }
@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/StreetGraph.h"
+#include "Data/DefinitionCatalog.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+
+void FStreetGraph::Reset()
+{
+	EdgeOffsets.Reset();
+	Edges.Reset();
+	NodeWidth.Reset();
+	RouteTreeCache.Reset();
+}
+
+void FStreetGraph::Build(UDefinitionCatalog& Catalog, const TMap<FName, TMap<FName, FName>>& Generated)
+{
+	Reset();
+
+	const TArray<TObjectPtr<UStreetDefinition>>& Streets = Catalog.GetStreets();
+	const int32 Num = Streets.Num();
+
+	EdgeOffsets.Reserve(Num + 1);
+	NodeWidth.Reserve(Num);
+
+	for (int32 Node = 0; Node < Num; ++Node)
+	{
+		const UStreetDefinition* Street = Streets[Node];
+		EdgeOffsets.Add(Edges.Num());
+		NodeWidth.Add(Street->StreetWidth);
+
+		const TMap<FName, FName>* GeneratedExits = Generated.Find(Street->StreetID);
+
+		for (const FStreetExitLink& Exit : Street->Exits)
+		{
+			// 1. Hard-wired destination takes priority (building exits, highway exits, etc.)
+			int32 To = INDEX_NONE;
+			if (Exit.Destination)
+			{
+				To = Catalog.GetStreetIndex(Exit.Destination->StreetID);
+			}
+			// 2. Fall back to runtime graph
+			else if (GeneratedExits)
+			{
+				const FName* ToID = GeneratedExits->Find(Exit.ExitID);
+				if (ToID && !ToID->IsNone())
+					To = Catalog.GetStreetIndex(*ToID);
+			}
+
+			if (To == INDEX_NONE) continue;
+
+			FStreetGraphEdge& Edge = Edges.AddDefaulted_GetRef();
+			Edge.To     = To;
+			Edge.ExitID = Exit.ExitID;
+			Edge.Layout = Exit.Layout;
+		}
+	}
+
+	EdgeOffsets.Add(Edges.Num());
+}
+
+TConstArrayView<FStreetGraphEdge> FStreetGraph::GetEdges(int32 Node) const
+{
+	if (Node < 0 || Node >= NumNodes()) return {};
+	return TConstArrayView<FStreetGraphEdge>(Edges.GetData() + EdgeOffsets[Node], EdgeOffsets[Node + 1] - EdgeOffsets[Node]);
+}
+
+int32 FStreetGraph::FindEdge(int32 Node, FName ExitID) const
+{
+	if (Node < 0 || Node >= NumNodes()) return INDEX_NONE;
+
+	// Streets have a handful of exits — a linear scan beats hashing.
+	for (int32 E = EdgeOffsets[Node]; E < EdgeOffsets[Node + 1]; ++E)
+	{
+		if (Edges[E].ExitID == ExitID)
+			return E;
+	}
+	return INDEX_NONE;
+}
+
+const FStreetRouteTree& FStreetGraph::GetRouteTree(int32 Source, EStreetRouteMetric Metric) const
+{
+	const int32 Key = Source * 2 + static_cast<int32>(Metric);
+	if (const FStreetRouteTree* Cached = RouteTreeCache.Find(Key))
+		return *Cached;
+
+	if (RouteTreeCache.Num() >= MaxCachedTrees)
+		RouteTreeCache.Reset();
+
+	FStreetRouteTree& Tree = RouteTreeCache.Add(Key);
+	Tree.Source = Source;
+
+	const int32 Num = NumNodes();
+	Tree.ParentEdge.Init(INDEX_NONE, Num);
+	Tree.Cost.Init(-1.f, Num);
+	if (Source < 0 || Source >= Num) return Tree;
+
+	Tree.Cost[Source] = 0.f;
+
+	if (Metric == EStreetRouteMetric::StreetCount)
+	{
+		// Plain BFS — the node array doubles as the queue.
+		TArray<int32> Queue;
+		Queue.Reserve(Num);
+		Queue.Add(Source);
+
+		for (int32 Head = 0; Head < Queue.Num(); ++Head)
+		{
+			const int32 Node = Queue[Head];
+			for (int32 E = EdgeOffsets[Node]; E < EdgeOffsets[Node + 1]; ++E)
+			{
+				const int32 To = Edges[E].To;
+				if (Tree.Cost[To] >= 0.f) continue;
+
+				Tree.Cost[To]       = Tree.Cost[Node] + 1.f;
+				Tree.ParentEdge[To] = E;
+				Queue.Add(To);
+			}
+		}
+	}
+	else
+	{
+		// Dijkstra — walking into a street costs its width.
+		struct FOpen
+		{
+			float Cost;
+			int32 Node;
+			bool operator<(const FOpen& Other) const { return Cost < Other.Cost; }
+		};
+
+		TArray<FOpen> Heap;
+		Heap.HeapPush({ 0.f, Source });
+
+		while (Heap.Num() > 0)
+		{
+			FOpen Top;
+			Heap.HeapPop(Top, EAllowShrinking::No);
+			if (Top.Cost > Tree.Cost[Top.Node]) continue; // stale entry
+
+			for (int32 E = EdgeOffsets[Top.Node]; E < EdgeOffsets[Top.Node + 1]; ++E)
+			{
+				const int32 To      = Edges[E].To;
+				const float NewCost = Top.Cost + NodeWidth[To];
+				if (Tree.Cost[To] >= 0.f && Tree.Cost[To] <= NewCost) continue;
+
+				Tree.Cost[To]       = NewCost;
+				Tree.ParentEdge[To] = E;
+				Heap.HeapPush({ NewCost, To });
+			}
+		}
+	}
+
+	return Tree;
+}
+
+bool FStreetGraph::FindRoute(int32 From, int32 To, EStreetRouteMetric Metric, TArray<int32>& OutEdges) const
+{
+	OutEdges.Reset();
+
+	const FStreetRouteTree& Tree = GetRouteTree(From, Metric);
+	if (!Tree.IsReached(To)) return false;
+
+	// Walk parents back to the source, then reverse. Edge source = the node whose CSR range holds it.
+	for (int32 Node = To; Node != From; )
+	{
+		const int32 E = Tree.ParentEdge[Node];
+		OutEdges.Add(E);
+		Node = Algo::UpperBound(EdgeOffsets, E) - 1;
+	}
+
+	Algo::Reverse(OutEdges);
+	return true;
+}
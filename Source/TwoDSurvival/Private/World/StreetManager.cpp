@@ -10,12 +10,24 @@
 #include "World/CityDefinition.h"
 #include "Character/BaseCharacter.h"
 #include "Save/TwoDSurvivalSaveGame.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "Data/DefinitionCatalog.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Public
 // ─────────────────────────────────────────────────────────────────────────────
 
+void UStreetManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency<UDefinitionCatalog>();
+	Super::Initialize(Collection);
+}
+
 void UStreetManager::InitializeWithStreet(UStreetDefinition* StartStreet, FVector WorldOffset)
 {
 	if (!StartStreet) return;
@@ -25,105 +37,344 @@ void UStreetManager::InitializeWithStreet(UStreetDefinition* StartStreet, FVecto
 	PendingTransitionType = ETransitionType::Street;
 	PendingIncomingExitID = FName("Start");  // place AExitSpawnPoint SpawnID="Start" in starting street
 	StreamingToUnload     = nullptr;
+	StreetToUnload        = nullptr;
 
 	StartingStreetDef = StartStreet;
 	VisitedStreetIDs.Add(StartStreet->StreetID);
 
-	// Generate city graph on fresh start. If LoadGame runs later it will overwrite this.
+	// A fresh world — nothing captured in a previous one still exists.
+	StreetStates.Reset();
+	TransitionQueue.Reset();
+
+	if (bSeamlessStreetWindow)
+	{
+		GetGameInstance()->GetTimerManager().SetTimer(
+			WindowCheckTimer, this, &UStreetManager::CheckWindowCrossing, WindowCheckInterval, /*bLoop=*/true);
+	}
+
+	// Generate city graph on fresh start with a new world seed. If LoadGame runs later it
+	// regenerates from the saved seed.
 	if (!bCityGenerated)
-		GenerateCityGraph();
+		GenerateCityGraph(static_cast<int32>(FPlatformTime::Cycles()));
 
+	TransitionTimeline.Begin(StartStreet->StreetID);
 	LoadStreet(StartStreet, WorldOffset);
 }
 
-void UStreetManager::OnPlayerCrossedExit(FName ExitID)
+void UStreetManager::OnPlayerCrossedExit(FName ExitID, const ULevel* SourceLevel)
 {
-	if (bTransitionInProgress) return;
 	if (!CurrentStreet)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[StreetManager] OnPlayerCrossedExit: CurrentStreet not set yet."));
 		return;
 	}
 
-	UStreetDefinition* Destination = ResolveExitDestination(CurrentStreet, ExitID);
+	// Triggers belong to the street whose level they sit in — the active one, or the pending
+	// one once it is shown. Anything else applies to wherever the queue will end up.
+	UStreetDefinition* From = GetTransitionChainStreet(TransitionChainLength() - 1);
+	if (SourceLevel)
+	{
+		if (ActiveStreaming && ActiveStreaming->GetLoadedLevel() == SourceLevel)
+		{
+			From = CurrentStreet;
+		}
+		else if (bTransitionInProgress && PendingStreaming && PendingStreaming->GetLoadedLevel() == SourceLevel)
+		{
+			From = PendingStreet;
+		}
+		else if (IsInactiveStreetLevel(SourceLevel))
+		{
+			// A neighbour shown by the seamless window — its exit IDs don't apply to the current street.
+			return;
+		}
+	}
+
+	// The seamless window switches streets by player X (CheckWindowCrossing) — triggers would fight it.
+	if (bSeamlessStreetWindow && GetExitLayout(From, ExitID) != EExitLayout::Building) return;
+
+	RequestTransition(From, ExitID, /*bExitBuilding=*/false);
+}
+
+void UStreetManager::OnPlayerExitBuilding()
+{
+	const int32 Tail = TransitionChainLength() - 1;
+	if (!IsTransitionChainInterior(Tail))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StreetManager] OnPlayerExitBuilding called but not inside a building."));
+		return;
+	}
+
+	RequestTransition(GetTransitionChainStreet(Tail), NAME_None, /*bExitBuilding=*/true);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Private — transition queue
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// The transition chain is CurrentStreet followed by the destination of every step in
+// TransitionQueue. Step 0 is in flight while bTransitionInProgress; the rest start in order
+// as each one finishes, so OnStreetChanged fires once per step, strictly in order.
+
+int32 UStreetManager::TransitionChainLength() const
+{
+	return TransitionQueue.Num() + 1;
+}
+
+UStreetDefinition* UStreetManager::GetTransitionChainStreet(int32 Index) const
+{
+	return Index <= 0 ? CurrentStreet.Get() : TransitionQueue[Index - 1].To.Get();
+}
+
+FVector UStreetManager::GetTransitionChainOffset(int32 Index) const
+{
+	return Index <= 0 ? CurrentStreetWorldOffset : TransitionQueue[Index - 1].ToOffset;
+}
+
+bool UStreetManager::IsTransitionChainInterior(int32 Index) const
+{
+	if (Index <= 0) return bIsInsideBuilding;
+
+	const FStreetTransitionStep& Step = TransitionQueue[Index - 1];
+	return !Step.bExitBuilding && Step.Layout == EExitLayout::Building;
+}
+
+EExitLayout UStreetManager::GetExitLayout(const UStreetDefinition* Street, FName ExitID)
+{
+	// Use the declared exit if available, otherwise infer from convention.
+	if (const FStreetExitLink* Link = Street ? Street->GetExit(ExitID) : nullptr)
+		return Link->Layout;
+
+	return ExitID == FName("Left") ? EExitLayout::AdjacentLeft : EExitLayout::AdjacentRight;
+}
+
+bool UStreetManager::ResolveTransitionStep(int32 FromIndex, FName ExitID, bool bExitBuilding,
+	FStreetTransitionStep& OutStep) const
+{
+	UStreetDefinition* From = GetTransitionChainStreet(FromIndex);
+	if (!From) return false;
+
+	OutStep.From          = From;
+	OutStep.FromOffset    = GetTransitionChainOffset(FromIndex);
+	OutStep.ExitID        = ExitID;
+	OutStep.bExitBuilding = bExitBuilding;
+
+	if (bExitBuilding)
+	{
+		// Back to the street the most recent entry into this interior started from.
+		for (int32 i = FromIndex; i > 0; --i)
+		{
+			const FStreetTransitionStep& Enter = TransitionQueue[i - 1];
+			if (!Enter.bExitBuilding && Enter.Layout == EExitLayout::Building)
+			{
+				OutStep.To       = Enter.From;
+				OutStep.ToOffset = Enter.FromOffset;
+				return OutStep.To != nullptr;
+			}
+		}
+
+		OutStep.To       = ReturnStreet;
+		OutStep.ToOffset = ReturnStreetOffset;
+		return OutStep.To != nullptr;
+	}
+
+	UStreetDefinition* Destination = ResolveExitDestination(From, ExitID);
 	if (!Destination)
 	{
 		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Exit '%s' is blocked or not defined on '%s'."),
-			*ExitID.ToString(), *CurrentStreet->StreetID.ToString());
+			*ExitID.ToString(), *From->StreetID.ToString());
+		return false;
+	}
+
+	OutStep.To     = Destination;
+	OutStep.Layout = GetExitLayout(From, ExitID);
+
+	// Interiors sit BuildingWorldX past the street they are entered from, so they stay
+	// near the (rebased) world origin however far along the city the player is.
+	OutStep.ToOffset = OutStep.Layout == EExitLayout::Building
+		? FVector(OutStep.FromOffset.X + BuildingWorldX, 0.f, 0.f)
+		: ComputeAdjacentOffset(From, OutStep.FromOffset, OutStep.Layout, Destination);
+	return true;
+}
+
+void UStreetManager::RequestTransition(UStreetDefinition* From, FName ExitID, bool bExitBuilding)
+{
+	// Latest chain position on From — earlier visits are history the player has walked past.
+	int32 FromIndex = INDEX_NONE;
+	for (int32 i = TransitionChainLength() - 1; i >= 0; --i)
+	{
+		if (GetTransitionChainStreet(i) == From) { FromIndex = i; break; }
+	}
+	if (FromIndex == INDEX_NONE) return;
+
+	const int32 Tail = TransitionChainLength() - 1;
+
+	// The step leaving From is already planned — a re-fired trigger, nothing new.
+	if (FromIndex < Tail)
+	{
+		const FStreetTransitionStep& Next = TransitionQueue[FromIndex];
+		if (Next.ExitID == ExitID && Next.bExitBuilding == bExitBuilding) return;
+	}
+
+	FStreetTransitionStep Step;
+	if (!ResolveTransitionStep(FromIndex, ExitID, bExitBuilding, Step)) return;
+
+	// A new course from an earlier street drops everything planned after it.
+	if (FromIndex < Tail)
+		TruncateTransitionQueue(FromIndex);
+
+	// Reverse crossing — the step undoes the last one, so cancel that instead of stacking a load.
+	if (FromIndex > 0)
+	{
+		if (GetTransitionChainStreet(FromIndex - 1) == Step.To
+			&& GetTransitionChainOffset(FromIndex - 1).Equals(Step.ToOffset, 1.f))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[StreetManager] Reverse crossing back to '%s' — cancelling '%s'."),
+				*Step.To->StreetID.ToString(), *From->StreetID.ToString());
+			TruncateTransitionQueue(FromIndex - 1);
+			return;
+		}
+	}
+
+	if (TransitionQueue.Num() >= MaxQueuedTransitions)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StreetManager] Transition queue full (%d) — dropping exit '%s'."),
+			MaxQueuedTransitions, *ExitID.ToString());
 		return;
 	}
 
-	// Determine layout: use declared exit if available, otherwise infer from convention.
-	const FStreetExitLink* Link = CurrentStreet->GetExit(ExitID);
-	EExitLayout Layout = EExitLayout::AdjacentRight;
-	if (Link)
-		Layout = Link->Layout;
-	else if (ExitID == FName("Left"))
-		Layout = EExitLayout::AdjacentLeft;
+	TransitionQueue.Add(Step);
 
+	// While a finished step is still broadcasting, OnNewStreetShown starts the next one itself.
+	if (!bTransitionInProgress && !bCommittingTransition)
+	{
+		StartTransitionStep(TransitionQueue[0]);
+		return;
+	}
+
+	// Pipelining: load the queued destination hidden now so its turn is only a visibility flip.
+	if (FindResidentLevel(Step.To, Step.ToOffset) == INDEX_NONE && !Step.To->Level.IsNull())
+	{
+		if (ULevelStreamingDynamic* Streaming = StartLevelLoad(Step.To, Step.ToOffset, /*bVisible=*/false))
+		{
+			FResidentStreetLevel& Resident = ResidentLevels.AddDefaulted_GetRef();
+			Resident.Street      = Step.To;
+			Resident.Offset      = Step.ToOffset;
+			Resident.Streaming   = Streaming;
+			Resident.bPrefetched = true;
+			Resident.LastUsed    = ++ResidentUseCounter;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Queued '%s' → '%s' (%d step(s) ahead)."),
+		*Step.From->StreetID.ToString(), *Step.To->StreetID.ToString(), TransitionQueue.Num() - 1);
+}
+
+void UStreetManager::TruncateTransitionQueue(int32 KeepSteps)
+{
+	if (KeepSteps >= TransitionQueue.Num()) return;
+
+	// Step 0 is in flight — pull its level back before dropping it.
+	if (KeepSteps == 0 && bTransitionInProgress)
+		CancelInFlightTransition();
+
+	TransitionQueue.SetNum(KeepSteps);
+}
+
+void UStreetManager::StartTransitionStep(const FStreetTransitionStep& Step)
+{
 	bTransitionInProgress = true;
+	TransitionTimeline.Begin(Step.To->StreetID);
+
+	StreamingToUnload    = ActiveStreaming;
+	StreetToUnload       = CurrentStreet;
+	StreetToUnloadOffset = CurrentStreetWorldOffset;
+	PendingStreet        = Step.To;
+	PendingOffset        = Step.ToOffset;
 
-	if (Layout == EExitLayout::Building)
+	if (Step.bExitBuilding)
+	{
+		// ── Exit building ────────────────────────────────────────────────────
+		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Exiting building — returning to '%s'."),
+			*Step.To->StreetID.ToString());
+
+		PendingTransitionType = ETransitionType::ExitBuilding;
+	}
+	else if (Step.Layout == EExitLayout::Building)
 	{
 		// ── Enter building ───────────────────────────────────────────────────
 		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Entering building '%s' via exit '%s'."),
-			*Destination->StreetID.ToString(), *ExitID.ToString());
+			*Step.To->StreetID.ToString(), *Step.ExitID.ToString());
 
 		ReturnStreet          = CurrentStreet;
 		ReturnStreetOffset    = CurrentStreetWorldOffset;
-		ReturnPlayerLocation  = GetPlayerLocation();
-		PendingIncomingExitID = ExitID;
-
+		ReturnPlayerLocation  = GetPlayerLocation() + GetWorldOrigin();
+		PendingIncomingExitID = Step.ExitID;
 		PendingTransitionType = ETransitionType::EnterBuilding;
-		StreamingToUnload     = ActiveStreaming;
-		PendingStreet         = Destination;
-		PendingOffset         = FVector(BuildingWorldX, 0.f, 0.f);
-
-		LoadStreet(Destination, FVector(BuildingWorldX, 0.f, 0.f));
 	}
 	else
 	{
 		// ── Adjacent street (walk-through) ───────────────────────────────────
-		const FVector NextOffset = ComputeAdjacentOffset(Layout, Destination);
-
 		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Crossing exit '%s' → '%s' at X=%.0f."),
-			*ExitID.ToString(), *Destination->StreetID.ToString(), NextOffset.X);
+			*Step.ExitID.ToString(), *Step.To->StreetID.ToString(), Step.ToOffset.X);
 
+		// In the seamless window the player walks in — no AExitSpawnPoint snap.
+		PendingIncomingExitID = bSeamlessStreetWindow ? NAME_None : Step.ExitID;
 		PendingTransitionType = ETransitionType::Street;
-		PendingIncomingExitID = ExitID;
-		StreamingToUnload     = ActiveStreaming;
-		PendingStreet         = Destination;
-		PendingOffset         = NextOffset;
-
-		LoadStreet(Destination, NextOffset);
 	}
+
+	LoadStreet(Step.To, Step.ToOffset);
 }
 
-void UStreetManager::OnPlayerExitBuilding()
+void UStreetManager::CancelInFlightTransition()
 {
-	if (bTransitionInProgress) return;
-	if (!bIsInsideBuilding)
+	if (ULevelStreamingDynamic* Streaming = PendingStreaming)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[StreetManager] OnPlayerExitBuilding called but not inside a building."));
-		return;
-	}
-	if (!ReturnStreet)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[StreetManager] OnPlayerExitBuilding: no ReturnStreet saved."));
-		return;
+		Streaming->OnLevelShown.RemoveDynamic(this, &UStreetManager::OnNewStreetShown);
+		Streaming->OnLevelLoaded.RemoveDynamic(this, &UStreetManager::OnPendingLevelLoaded);
+		Streaming->SetShouldBeVisible(false);
+
+		// Keep it loaded — the player was just at its edge and may well turn around again.
+		FResidentStreetLevel& Resident = ResidentLevels.AddDefaulted_GetRef();
+		Resident.Street    = PendingStreet;
+		Resident.Offset    = PendingOffset;
+		Resident.Streaming = Streaming;
+		Resident.LastUsed  = ++ResidentUseCounter;
 	}
 
-	bTransitionInProgress = true;
+	if (PendingTransitionType == ETransitionType::EnterBuilding)
+		ReturnStreet = nullptr;
 
-	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Exiting building — returning to '%s'."),
-		*ReturnStreet->StreetID.ToString());
+	PendingStreaming      = nullptr;
+	PendingStreet         = nullptr;
+	StreamingToUnload     = nullptr;
+	StreetToUnload        = nullptr;
+	PendingIncomingExitID = NAME_None;
+	PendingTransitionType = ETransitionType::Street;
+	bTransitionInProgress = false;
+	TransitionTimeline.Cancel();
 
-	PendingTransitionType = ETransitionType::ExitBuilding;
-	StreamingToUnload     = ActiveStreaming;
-	PendingStreet         = ReturnStreet;
-	PendingOffset         = ReturnStreetOffset;
+	TrimResidentCache();
+}
 
-	LoadStreet(ReturnStreet, ReturnStreetOffset);
+bool UStreetManager::IsQueuedDestination(const UStreetDefinition* Street, const FVector& Offset) const
+{
+	return TransitionQueue.ContainsByPredicate([Street, &Offset](const FStreetTransitionStep& Step)
+	{
+		return Step.To == Street && Step.ToOffset.Equals(Offset, 1.f);
+	});
+}
+
+void UStreetManager::AbortTransition()
+{
+	PendingStreet         = nullptr;
+	StreamingToUnload     = nullptr;
+	StreetToUnload        = nullptr;
+	PendingTransitionType = ETransitionType::Street;
+	bTransitionInProgress = false;
+	TransitionTimeline.Cancel();
+
+	// Everything queued was planned from a street the player never reached.
+	TransitionQueue.Reset();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -136,12 +387,73 @@ void UStreetManager::LoadStreet(UStreetDefinition* Street, FVector WorldOffset)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[StreetManager] LoadStreet: '%s' has no Level asset assigned."),
 			Street ? *Street->StreetID.ToString() : TEXT("null"));
-		bTransitionInProgress = false;
+		AbortTransition();
+		return;
+	}
+
+	// Resident hit (prefetched or cached) — the level is already loaded, just make it visible.
+	const int32 ResidentIdx = FindResidentLevel(Street, WorldOffset);
+	if (ResidentIdx != INDEX_NONE)
+	{
+		ULevelStreamingDynamic* Streaming = ResidentLevels[ResidentIdx].Streaming;
+		const bool bWasPrefetched = ResidentLevels[ResidentIdx].bPrefetched;
+		ResidentLevels.RemoveAtSwap(ResidentIdx);
+		++ResidentCacheHits;
+
+		UE_LOG(LogTemp, Log, TEXT("[StreetManager] '%s' is already resident (%s) — showing it. Hits %d / misses %d."),
+			*Street->StreetID.ToString(), bWasPrefetched ? TEXT("prefetched") : TEXT("cached"),
+			ResidentCacheHits, ResidentCacheMisses);
+
+		// Nothing to load from disk — Load is a zero-length phase.
+		TransitionTimeline.SetResident(true);
+		TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Request);
+		TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Load);
+
+		PendingStreaming = Streaming;
+		Streaming->SetShouldBeVisible(true);
+
+		// A level whose hide request hasn't been processed yet is still visible — OnLevelShown won't fire.
+		if (Streaming->IsLevelVisible())
+		{
+			OnNewStreetShown();
+		}
+		else
+		{
+			Streaming->OnLevelShown.AddDynamic(this, &UStreetManager::OnNewStreetShown);
+		}
+		return;
+	}
+
+	++ResidentCacheMisses;
+
+	ULevelStreamingDynamic* Streaming = StartLevelLoad(Street, WorldOffset, /*bVisible=*/true);
+	if (!Streaming)
+	{
+		AbortTransition();
 		return;
 	}
 
+	TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Request);
+
+	PendingStreaming = Streaming;
+	Streaming->OnLevelLoaded.AddDynamic(this, &UStreetManager::OnPendingLevelLoaded);
+	Streaming->OnLevelShown.AddDynamic(this, &UStreetManager::OnNewStreetShown);
+}
+
+void UStreetManager::OnPendingLevelLoaded()
+{
+	if (PendingStreaming)
+	{
+		PendingStreaming->OnLevelLoaded.RemoveDynamic(this, &UStreetManager::OnPendingLevelLoaded);
+	}
+
+	TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Load);
+}
+
+ULevelStreamingDynamic* UStreetManager::StartLevelLoad(UStreetDefinition* Street, FVector WorldOffset, bool bVisible)
+{
 	UWorld* World = GetGameInstance()->GetWorld();
-	if (!World) return;
+	if (!World) return nullptr;
 
 	bool bSuccess = false;
 	const FTransform LevelTransform(FQuat::Identity, WorldOffset, FVector::OneVector);
@@ -153,12 +465,28 @@ void UStreetManager::LoadStreet(UStreetDefinition* Street, FVector WorldOffset)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[StreetManager] LoadLevelInstanceBySoftObjectPtr failed for '%s'."),
 			*Street->StreetID.ToString());
-		bTransitionInProgress = false;
-		return;
+		return nullptr;
 	}
 
-	PendingStreaming = Streaming;
-	Streaming->OnLevelShown.AddDynamic(this, &UStreetManager::OnNewStreetShown);
+	// Background loads stay out of the world (no actors, no collision) until made visible.
+	if (!bVisible)
+	{
+		Streaming->SetShouldBeVisible(false);
+	}
+
+	return Streaming;
+}
+
+void UStreetManager::UnloadLevel(ULevelStreamingDynamic* Streaming)
+{
+	if (!Streaming) return;
+
+	if (ULevel* Level = Streaming->GetLoadedLevel())
+		LevelMarkers.Remove(Level);
+
+	Streaming->SetShouldBeLoaded(false);
+	Streaming->SetShouldBeVisible(false);
+	Streaming->SetIsRequestingUnloadAndRemoval(true);
 }
 
 void UStreetManager::OnNewStreetShown()
@@ -167,14 +495,39 @@ void UStreetManager::OnNewStreetShown()
 	if (PendingStreaming)
 	{
 		PendingStreaming->OnLevelShown.RemoveDynamic(this, &UStreetManager::OnNewStreetShown);
+
+		// OnLevelLoaded didn't reach us first — close Load here so phases stay in order.
+		if (PendingStreaming->OnLevelLoaded.IsAlreadyBound(this, &UStreetManager::OnPendingLevelLoaded))
+		{
+			OnPendingLevelLoaded();
+		}
 	}
 
-	// Unload the previous sublevel
+	// AddToWorld (and every actor's BeginPlay in the new level) happened between load and here.
+	TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Show);
+
+	// Retire the previous sublevel — it stays loaded, either as a neighbour of the new street
+	// (shown in the seamless window, hidden otherwise) or as the most recent LRU cache entry.
+	// UpdatePrefetch() below re-pins neighbours, sets visibility and trims the cache.
 	if (StreamingToUnload)
 	{
-		StreamingToUnload->SetShouldBeLoaded(false);
-		StreamingToUnload->SetShouldBeVisible(false);
+		if (StreetToUnload)
+		{
+			// Still shown for now — UpdatePrefetch() hides it (capturing its street state)
+			// unless it is a neighbour in the seamless window.
+			FResidentStreetLevel& Resident = ResidentLevels.AddDefaulted_GetRef();
+			Resident.Street    = StreetToUnload;
+			Resident.Offset    = StreetToUnloadOffset;
+			Resident.Streaming = StreamingToUnload;
+			Resident.bVisible  = true;
+			Resident.LastUsed  = ++ResidentUseCounter;
+		}
+		else
+		{
+			UnloadLevel(StreamingToUnload);
+		}
 		StreamingToUnload = nullptr;
+		StreetToUnload    = nullptr;
 	}
 
 	// Commit new state
@@ -197,8 +550,27 @@ void UStreetManager::OnNewStreetShown()
 	PendingStreet             = nullptr;
 	bTransitionInProgress     = false;
 
+	// The finished step leaves the queue now; the next one waits until OnStreetChanged is out.
+	if (TransitionQueue.Num() > 0)
+		TransitionQueue.RemoveAt(0);
+	bCommittingTransition = true;
+
 	ULevel* LoadedLevel = ActiveStreaming ? ActiveStreaming->GetLoadedLevel() : nullptr;
 
+	// Index spawn points / entrances once per load — resident levels keep theirs when reshown.
+	if (LoadedLevel)
+		GetOrBuildMarkers(LoadedLevel);
+
+	// Bring back the enemies, pickups, doors and breakables captured when the street was left.
+	// A window neighbour that just became current is already live — Restore is a no-op then.
+	UWorld* World = GetGameInstance()->GetWorld();
+	UDefinitionCatalog* Catalog = GetCatalog();
+	if (CurrentStreet && World && Catalog)
+	{
+		StreetStates.Restore(World, CurrentStreet->StreetID, CurrentStreetWorldOffset - GetWorldOrigin(),
+			CurrentStreet->StreetWidth, *Catalog);
+	}
+
 	// ── Post-load behaviour per transition type ───────────────────────────────
 	switch (PendingTransitionType)
 	{
@@ -213,7 +585,7 @@ void UStreetManager::OnNewStreetShown()
 
 	case ETransitionType::ExitBuilding:
 		bIsInsideBuilding = false;
-		TeleportPlayerToLocation(ReturnPlayerLocation);
+		TeleportPlayerToLocation(ReturnPlayerLocation - GetWorldOrigin());
 		ReturnStreet = nullptr;
 
 		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Exited building — back on '%s' at X=%.0f."),
@@ -232,17 +604,30 @@ void UStreetManager::OnNewStreetShown()
 	}
 
 	PendingTransitionType = ETransitionType::Street;
+	RebaseWorldOriginIfNeeded();
+	TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Teleport);
+
+	UpdatePrefetch();
+	TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Prefetch);
+
 	OnStreetChanged.Broadcast();
+	TransitionTimeline.MarkPhaseEnd(EStreetTransitionPhase::Broadcast);
+	TransitionTimeline.End();
+
+	bCommittingTransition = false;
+	if (TransitionQueue.Num() > 0)
+		StartTransitionStep(TransitionQueue[0]);
 }
 
-FVector UStreetManager::ComputeAdjacentOffset(EExitLayout Layout, UStreetDefinition* AdjacentStreet) const
+FVector UStreetManager::ComputeAdjacentOffset(UStreetDefinition* FromStreet, const FVector& FromOffset,
+	EExitLayout Layout, UStreetDefinition* AdjacentStreet)
 {
-	FVector Offset = CurrentStreetWorldOffset;
+	FVector Offset = FromOffset;
 
 	switch (Layout)
 	{
 	case EExitLayout::AdjacentRight:
-		Offset.X += CurrentStreet->StreetWidth;
+		Offset.X += FromStreet->StreetWidth;
 		break;
 
 	case EExitLayout::AdjacentLeft:
@@ -256,6 +641,266 @@ FVector UStreetManager::ComputeAdjacentOffset(EExitLayout Layout, UStreetDefinit
 	return Offset;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Private — prefetch
+// ─────────────────────────────────────────────────────────────────────────────
+
+int32 UStreetManager::FindResidentLevel(const UStreetDefinition* Street, const FVector& Offset) const
+{
+	return ResidentLevels.IndexOfByPredicate([Street, &Offset](const FResidentStreetLevel& R)
+	{
+		return R.Street == Street && R.Offset.Equals(Offset, 1.f);
+	});
+}
+
+void UStreetManager::UpdatePrefetch()
+{
+	struct FWantedLevel { UStreetDefinition* Street; FVector Offset; int32 Depth; };
+	TArray<FWantedLevel> Wanted;
+
+	auto FindWanted = [&Wanted](const UStreetDefinition* Street, const FVector& Offset) -> const FWantedLevel*
+	{
+		return Wanted.FindByPredicate([Street, &Offset](const FWantedLevel& W)
+		{
+			return W.Street == Street && W.Offset.Equals(Offset, 1.f);
+		});
+	};
+
+	// The seamless window needs the direct neighbours, plus the next ring for its hysteresis.
+	const int32 SearchDepth = bSeamlessStreetWindow ? FMath::Max(PrefetchDepth, 2) : PrefetchDepth;
+
+	// Building interiors have no walk-through neighbours — prefetch only while on a street.
+	if (SearchDepth > 0 && CurrentStreet && !bIsInsideBuilding)
+	{
+		float BudgetLeftMB = PrefetchMemoryBudgetMB;
+		TArray<FWantedLevel> Frontier = { { CurrentStreet, CurrentStreetWorldOffset, 0 } };
+
+		// Breadth-first so the nearest neighbours claim the memory budget first.
+		for (int32 Depth = 1; Depth <= SearchDepth && Frontier.Num() > 0; ++Depth)
+		{
+			TArray<FWantedLevel> NextFrontier;
+			for (const FWantedLevel& From : Frontier)
+			{
+				for (const FStreetExitLink& Exit : From.Street->Exits)
+				{
+					if (Exit.Layout == EExitLayout::Building) continue;
+
+					UStreetDefinition* Dest = ResolveExitDestination(From.Street, Exit.ExitID);
+					if (!Dest || Dest->Level.IsNull()) continue;
+
+					const FVector Offset = ComputeAdjacentOffset(From.Street, From.Offset, Exit.Layout, Dest);
+					if (Dest == CurrentStreet && Offset.Equals(CurrentStreetWorldOffset, 1.f)) continue;
+					if (FindWanted(Dest, Offset)) continue;
+
+					// Window neighbours are always loaded; everything else is budgeted.
+					const bool bWindow = bSeamlessStreetWindow && Depth == 1;
+					if (!bWindow && Dest->EstimatedMemoryMB > BudgetLeftMB) continue;
+
+					BudgetLeftMB -= Dest->EstimatedMemoryMB;
+					Wanted.Add({ Dest, Offset, Depth });
+					NextFrontier.Add({ Dest, Offset, Depth });
+				}
+			}
+			Frontier = MoveTemp(NextFrontier);
+		}
+	}
+
+	// Shown = direct neighbour, or a second-ring level that is already shown. Pacing across one
+	// boundary only moves the window's far edge by one street, which the second ring absorbs.
+	auto ShouldShow = [this](const FWantedLevel* W, bool bCurrentlyVisible)
+	{
+		return bSeamlessStreetWindow && W && (W->Depth == 1 || (W->Depth == 2 && bCurrentlyVisible));
+	};
+
+	// Re-pin resident levels against the new prefetch set. Anything that fell out of it
+	// becomes an ordinary cache entry and competes in the LRU below.
+	for (FResidentStreetLevel& Resident : ResidentLevels)
+	{
+		const FWantedLevel* W = FindWanted(Resident.Street, Resident.Offset);
+		Resident.bPrefetched = W != nullptr || IsQueuedDestination(Resident.Street, Resident.Offset);
+		SetResidentVisible(Resident, ShouldShow(W, Resident.bVisible));
+	}
+
+	// Start background loads for anything not yet resident — visible for window neighbours.
+	int32 Started = 0;
+	for (const FWantedLevel& W : Wanted)
+	{
+		if (FindResidentLevel(W.Street, W.Offset) != INDEX_NONE) continue;
+
+		const bool bShow = ShouldShow(&W, false);
+		if (ULevelStreamingDynamic* Streaming = StartLevelLoad(W.Street, W.Offset, bShow))
+		{
+			FResidentStreetLevel& Resident = ResidentLevels.AddDefaulted_GetRef();
+			Resident.Street      = W.Street;
+			Resident.Offset      = W.Offset;
+			Resident.Streaming   = Streaming;
+			Resident.bPrefetched = true;
+			Resident.bVisible    = bShow;
+			Resident.LastUsed    = ++ResidentUseCounter;
+			++Started;
+
+			if (bShow)
+				Streaming->OnLevelShown.AddUniqueDynamic(this, &UStreetManager::OnResidentLevelShown);
+		}
+	}
+
+	TrimResidentCache();
+
+	if (Started > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Prefetching %d level(s) — %d resident in the background."),
+			Started, ResidentLevels.Num());
+	}
+}
+
+void UStreetManager::TrimResidentCache()
+{
+	int32 CachedCount = 0;
+	float CachedMB    = 0.f;
+	for (const FResidentStreetLevel& Resident : ResidentLevels)
+	{
+		if (Resident.bPrefetched) continue;
+		++CachedCount;
+		CachedMB += Resident.Street ? Resident.Street->EstimatedMemoryMB : 0.f;
+	}
+
+	while (CachedCount > MaxCachedLevels || (CachedCount > 0 && CachedMB > CacheMemoryBudgetMB))
+	{
+		// Evict the least recently used non-prefetched level.
+		int32 Oldest = INDEX_NONE;
+		for (int32 i = 0; i < ResidentLevels.Num(); ++i)
+		{
+			if (ResidentLevels[i].bPrefetched) continue;
+			if (Oldest == INDEX_NONE || ResidentLevels[i].LastUsed < ResidentLevels[Oldest].LastUsed)
+				Oldest = i;
+		}
+		if (Oldest == INDEX_NONE) break;
+
+		const FResidentStreetLevel& Evicted = ResidentLevels[Oldest];
+		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Evicting cached level '%s' at X=%.0f."),
+			Evicted.Street ? *Evicted.Street->StreetID.ToString() : TEXT("null"), Evicted.Offset.X);
+
+		--CachedCount;
+		CachedMB -= Evicted.Street ? Evicted.Street->EstimatedMemoryMB : 0.f;
+		UnloadLevel(Evicted.Streaming);
+		ResidentLevels.RemoveAtSwap(Oldest);
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Private — seamless window
+// ─────────────────────────────────────────────────────────────────────────────
+
+void UStreetManager::SetResidentVisible(FResidentStreetLevel& Resident, bool bVisible)
+{
+	if (!Resident.Streaming || !Resident.Street || Resident.bVisible == bVisible) return;
+	Resident.bVisible = bVisible;
+
+	if (!bVisible)
+	{
+		// Its actors run BeginPlay again when reshown — keep what happened there in the store.
+		UWorld* World = GetGameInstance()->GetWorld();
+		UDefinitionCatalog* Catalog = GetCatalog();
+		if (World && Catalog)
+		{
+			StreetStates.Capture(World, Resident.Street->StreetID, Resident.Offset - GetWorldOrigin(),
+				Resident.Street->StreetWidth, *Catalog);
+		}
+
+		Resident.Streaming->SetShouldBeVisible(false);
+		return;
+	}
+
+	Resident.Streaming->SetShouldBeVisible(true);
+	Resident.Streaming->OnLevelShown.AddUniqueDynamic(this, &UStreetManager::OnResidentLevelShown);
+
+	// A level whose hide request hasn't been processed yet is still visible — OnLevelShown won't fire.
+	if (Resident.Streaming->IsLevelVisible())
+		OnResidentLevelShown();
+}
+
+void UStreetManager::OnResidentLevelShown()
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	UDefinitionCatalog* Catalog = GetCatalog();
+	if (!World || !Catalog) return;
+
+	// Restore is a no-op for streets that are already live, so just sweep every shown neighbour.
+	for (const FResidentStreetLevel& Resident : ResidentLevels)
+	{
+		if (!Resident.bVisible || !Resident.Street || !Resident.Streaming) continue;
+		if (!Resident.Streaming->IsLevelVisible()) continue;
+
+		StreetStates.Restore(World, Resident.Street->StreetID, Resident.Offset - GetWorldOrigin(),
+			Resident.Street->StreetWidth, *Catalog);
+	}
+}
+
+void UStreetManager::CheckWindowCrossing()
+{
+	if (!bSeamlessStreetWindow || !CurrentStreet) return;
+
+	// Measure against where the queue ends up — walking back into the street a pending load
+	// started from resolves to a reverse crossing and cancels it.
+	const int32 Tail = TransitionChainLength() - 1;
+	if (IsTransitionChainInterior(Tail)) return;
+
+	UStreetDefinition* Street = GetTransitionChainStreet(Tail);
+	const FVector Offset      = GetTransitionChainOffset(Tail);
+	if (!Street) return;
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PC || !PC->GetPawn()) return;
+
+	const float PlayerX = PC->GetPawn()->GetActorLocation().X + GetWorldOrigin().X;
+	const float LeftEdge  = Offset.X;
+	const float RightEdge = Offset.X + Street->StreetWidth;
+
+	// The margin is the hysteresis: stepping back and forth over an edge never switches.
+	EExitLayout Side;
+	if (PlayerX < LeftEdge - WindowSwitchMargin)
+		Side = EExitLayout::AdjacentLeft;
+	else if (PlayerX > RightEdge + WindowSwitchMargin)
+		Side = EExitLayout::AdjacentRight;
+	else
+		return;
+
+	for (const FStreetExitLink& Exit : Street->Exits)
+	{
+		if (Exit.Layout != Side) continue;
+
+		if (ResolveExitDestination(Street, Exit.ExitID))
+		{
+			RequestTransition(Street, Exit.ExitID, /*bExitBuilding=*/false);
+			return;
+		}
+	}
+}
+
+void UStreetManager::RebaseWorldOriginIfNeeded()
+{
+	if (WorldRebaseDistance <= 0.f || bIsInsideBuilding) return;
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World) return;
+
+	const FVector Origin = GetWorldOrigin();
+	if (FMath::Abs(CurrentStreetWorldOffset.X - Origin.X) < WorldRebaseDistance) return;
+
+	// Shifts every visible level and actor; hidden levels are shifted when next added to the world.
+	const FIntVector NewOrigin(FMath::RoundToInt(CurrentStreetWorldOffset.X), World->OriginLocation.Y, World->OriginLocation.Z);
+	World->SetNewWorldOrigin(NewOrigin);
+
+	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Rebased world origin to X=%d (was %.0f)."), NewOrigin.X, Origin.X);
+}
+
+FVector UStreetManager::GetWorldOrigin() const
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	return World ? FVector(World->OriginLocation) : FVector::ZeroVector;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Private — teleport helpers
 // ─────────────────────────────────────────────────────────────────────────────
@@ -270,57 +915,95 @@ void UStreetManager::TeleportPlayerToSpawnPoint(ULevel* Level, FName IncomingExi
 	APlayerController* PC = World->GetFirstPlayerController();
 	if (!PC || !PC->GetPawn()) return;
 
+	const FLevelMarkerIndex& Markers = GetOrBuildMarkers(Level);
+
 	// First: look for an AExitSpawnPoint with a matching SpawnID.
-	for (AActor* Actor : Level->Actors)
+	if (AExitSpawnPoint* Spawn = Markers.FindExitSpawnPoint(IncomingExitID))
 	{
-		if (AExitSpawnPoint* Spawn = Cast<AExitSpawnPoint>(Actor))
+		PC->GetPawn()->SetActorLocation(
+			Spawn->GetActorLocation(),
+			/*bSweep=*/false,
+			/*OutSweepHitResult=*/nullptr,
+			ETeleportType::TeleportPhysics);
+
+		// Align movement axis and camera to the spawn point's orientation.
+		// bFlipCamera toggles which side of the street the camera sits on.
+		if (ABaseCharacter* Char = Cast<ABaseCharacter>(PC->GetPawn()))
 		{
-			if (Spawn->SpawnID == IncomingExitID)
-			{
-				PC->GetPawn()->SetActorLocation(
-					Spawn->GetActorLocation(),
-					/*bSweep=*/false,
-					/*OutSweepHitResult=*/nullptr,
-					ETeleportType::TeleportPhysics);
-
-				// Align movement axis and camera to the spawn point's orientation.
-				// bFlipCamera toggles which side of the street the camera sits on.
-				if (ABaseCharacter* Char = Cast<ABaseCharacter>(PC->GetPawn()))
-				{
-					const float SpawnYaw = Spawn->GetActorRotation().Yaw;
-					const float CameraYaw = Spawn->bFlipCamera ? SpawnYaw + 90.f : SpawnYaw - 90.f;
-					Char->SetMovementAxis(Spawn->GetActorForwardVector(), CameraYaw);
-				}
-
-				UE_LOG(LogTemp, Log, TEXT("[StreetManager] Teleported player to spawn point '%s' at %s."),
-					*IncomingExitID.ToString(), *Spawn->GetActorLocation().ToString());
-				return;
-			}
+			const float SpawnYaw = Spawn->GetActorRotation().Yaw;
+			const float CameraYaw = Spawn->bFlipCamera ? SpawnYaw + 90.f : SpawnYaw - 90.f;
+			Char->SetMovementAxis(Spawn->GetActorForwardVector(), CameraYaw);
 		}
+
+		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Teleported player to spawn point '%s' at %s."),
+			*IncomingExitID.ToString(), *Spawn->GetActorLocation().ToString());
+		return;
 	}
 
 	// Fallback: use the first ABuildingEntrance in the level (backward compatibility).
-	for (AActor* Actor : Level->Actors)
+	if (ABuildingEntrance* Entrance = Markers.GetFirstBuildingEntrance())
 	{
-		if (ABuildingEntrance* Entrance = Cast<ABuildingEntrance>(Actor))
-		{
-			PC->GetPawn()->SetActorLocation(
-				Entrance->GetActorLocation(),
-				/*bSweep=*/false,
-				/*OutSweepHitResult=*/nullptr,
-				ETeleportType::TeleportPhysics);
-
-			UE_LOG(LogTemp, Warning,
-				TEXT("[StreetManager] No AExitSpawnPoint with SpawnID='%s' found — fell back to ABuildingEntrance."),
-				*IncomingExitID.ToString());
-			return;
-		}
+		PC->GetPawn()->SetActorLocation(
+			Entrance->GetActorLocation(),
+			/*bSweep=*/false,
+			/*OutSweepHitResult=*/nullptr,
+			ETeleportType::TeleportPhysics);
+
+		UE_LOG(LogTemp, Warning,
+			TEXT("[StreetManager] No AExitSpawnPoint with SpawnID='%s' found — fell back to ABuildingEntrance."),
+			*IncomingExitID.ToString());
+		return;
 	}
 
 	UE_LOG(LogTemp, Warning,
 		TEXT("[StreetManager] TeleportPlayerToSpawnPoint: no AExitSpawnPoint or ABuildingEntrance found in level."));
 }
 
+const FLevelMarkerIndex& UStreetManager::GetOrBuildMarkers(ULevel* Level)
+{
+	if (const FLevelMarkerIndex* Existing = LevelMarkers.Find(Level))
+		return *Existing;
+
+	FLevelMarkerIndex& Markers = LevelMarkers.Add(Level, FLevelMarkerIndex::Build(Level));
+	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Indexed level markers: %d exit spawns, %d event spawns, %d entrances."),
+		Markers.ExitSpawnPoints.Num(), Markers.WorldEventSpawnPoints.Num(), Markers.BuildingEntrances.Num());
+	return Markers;
+}
+
+const FLevelMarkerIndex* UStreetManager::GetActiveMarkers() const
+{
+	ULevel* Level = ActiveStreaming ? ActiveStreaming->GetLoadedLevel() : nullptr;
+	return Level ? LevelMarkers.Find(Level) : nullptr;
+}
+
+bool UStreetManager::ShouldSuppressLevelSpawns(const ULevel* Level) const
+{
+	if (!Level) return false;
+
+	// BeginPlay for a newly shown level runs before OnNewStreetShown, while it is still pending
+	// — or, for a window neighbour, while it sits in ResidentLevels.
+	const UStreetDefinition* Street = nullptr;
+	if (PendingStreaming && PendingStreaming->GetLoadedLevel() == Level)
+	{
+		Street = PendingStreet;
+	}
+	else if (const FResidentStreetLevel* Resident = ResidentLevels.FindByPredicate(
+		[Level](const FResidentStreetLevel& R) { return R.Streaming && R.Streaming->GetLoadedLevel() == Level; }))
+	{
+		Street = Resident->Street;
+	}
+
+	return Street && StreetStates.Contains(Street->StreetID);
+}
+
+bool UStreetManager::IsInactiveStreetLevel(const ULevel* Level) const
+{
+	return Level && ResidentLevels.ContainsByPredicate([Level](const FResidentStreetLevel& R)
+	{
+		return R.Streaming && R.Streaming->GetLoadedLevel() == Level;
+	});
+}
+
 void UStreetManager::TeleportPlayerToLocation(FVector Location)
 {
 	UWorld* World = GetGameInstance()->GetWorld();
@@ -353,56 +1036,67 @@ FVector UStreetManager::GetPlayerLocation() const
 // Runtime city graph
 // ─────────────────────────────────────────────────────────────────────────────
 
-void UStreetManager::ScanAllStreetDefs()
+UDefinitionCatalog* UStreetManager::GetCatalog() const
 {
-	FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	ARM.Get().WaitForCompletion();
+	UGameInstance* GI = GetGameInstance();
+	return GI ? GI->GetSubsystem<UDefinitionCatalog>() : nullptr;
+}
 
-	TArray<FAssetData> Assets;
-	ARM.Get().GetAssetsByClass(UStreetDefinition::StaticClass()->GetClassPathName(), Assets);
+void UStreetManager::GenerateCityGraph(int32 Seed)
+{
+	UDefinitionCatalog* Catalog = GetCatalog();
+	if (!Catalog) return;
 
-	for (const FAssetData& AD : Assets)
-	{
-		UStreetDefinition* Def = Cast<UStreetDefinition>(AD.GetAsset());
-		if (Def && !Def->StreetID.IsNone())
-			AllStreetDefsMap.Add(Def->StreetID, Def);
-	}
+	// Catalog order is sorted by StreetID, so the same seed + asset set always yields the same graph.
+	BuildCityGraph(Catalog->GetStreets(), Seed, GeneratedGraph);
+	RebuildStreetGraph();
 
-	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Scanned %d street definitions."), AllStreetDefsMap.Num());
+	WorldSeed      = Seed;
+	bCityGenerated = true;
+	UE_LOG(LogTemp, Log, TEXT("[StreetManager] City graph generated from seed %d (%d street entries)."),
+		Seed, GeneratedGraph.Num());
 }
 
-void UStreetManager::GenerateCityGraph()
+void UStreetManager::BuildCityGraph(TConstArrayView<TObjectPtr<UStreetDefinition>> Streets, int32 Seed,
+	TMap<FName, TMap<FName, FName>>& OutGraph)
 {
-	ScanAllStreetDefs();
+	FRandomStream Rng(Seed);
 
 	// Group city streets (non-highway, non-building) by their OwnerCity.
+	// CityOrder keeps first-seen order so RNG draws happen in a stable sequence.
+	TArray<UCityDefinition*> CityOrder;
 	TMap<UCityDefinition*, TArray<UStreetDefinition*>> StreetsByCity;
-	for (auto& KV : AllStreetDefsMap)
+	for (UStreetDefinition* Def : Streets)
 	{
-		UStreetDefinition* Def = KV.Value.Get();
 		if (!Def || !Def->OwnerCity || Def->bIsHighway || Def->bIsPCGBuilding) continue;
-		StreetsByCity.FindOrAdd(Def->OwnerCity).Add(Def);
+
+		TArray<UStreetDefinition*>* Pool = StreetsByCity.Find(Def->OwnerCity);
+		if (!Pool)
+		{
+			CityOrder.Add(Def->OwnerCity);
+			Pool = &StreetsByCity.Add(Def->OwnerCity);
+		}
+		Pool->Add(Def);
 	}
 
-	GeneratedGraph.Empty();
+	OutGraph.Empty();
 
-	for (auto& CityKV : StreetsByCity)
+	for (UCityDefinition* City : CityOrder)
 	{
-		UCityDefinition* City = CityKV.Key;
-		TArray<UStreetDefinition*>& Pool = CityKV.Value;
+		TArray<UStreetDefinition*>& Pool = StreetsByCity.FindChecked(City);
 		if (Pool.IsEmpty()) continue;
 
 		// Fisher-Yates shuffle
 		for (int32 i = Pool.Num() - 1; i > 0; --i)
 		{
-			const int32 j = FMath::RandRange(0, i);
+			const int32 j = Rng.RandRange(0, i);
 			Pool.Swap(i, j);
 		}
 
 		// Pick N streets clamped to pool size
 		const int32 Min = FMath::Min(City->MinStreets, Pool.Num());
 		const int32 Max = FMath::Min(FMath::Max(City->MaxStreets, Min), Pool.Num());
-		const int32 N   = FMath::RandRange(Min, Max);
+		const int32 N   = Rng.RandRange(Min, Max);
 		Pool.SetNum(N);
 
 		// Collect all unassigned, non-building exits per layout direction.
@@ -428,10 +1122,10 @@ void UStreetManager::GenerateCityGraph()
 		}
 
 		// Shuffle both slot lists independently so pairings are random.
-		auto Shuffle = [](TArray<FExitSlot>& Arr)
+		auto Shuffle = [&Rng](TArray<FExitSlot>& Arr)
 		{
 			for (int32 i = Arr.Num() - 1; i > 0; --i)
-				Arr.Swap(i, FMath::RandRange(0, i));
+				Arr.Swap(i, Rng.RandRange(0, i));
 		};
 		Shuffle(RightSlots);
 		Shuffle(LeftSlots);
@@ -449,16 +1143,13 @@ void UStreetManager::GenerateCityGraph()
 
 			const FExitSlot& L = LeftSlots[Li++];
 
-			GeneratedGraph.FindOrAdd(R.Street->StreetID).Add(R.ExitID, L.Street->StreetID);
-			GeneratedGraph.FindOrAdd(L.Street->StreetID).Add(L.ExitID, R.Street->StreetID);
+			OutGraph.FindOrAdd(R.Street->StreetID).Add(R.ExitID, L.Street->StreetID);
+			OutGraph.FindOrAdd(L.Street->StreetID).Add(L.ExitID, R.Street->StreetID);
 		}
 
-		UE_LOG(LogTemp, Log, TEXT("[StreetManager] City '%s': %d streets, %d right-slots, %d left-slots paired."),
+		UE_LOG(LogTemp, Verbose, TEXT("[StreetManager] City '%s': %d streets, %d right-slots, %d left-slots paired."),
 			*City->CityName.ToString(), N, RightSlots.Num(), LeftSlots.Num());
 	}
-
-	bCityGenerated = true;
-	UE_LOG(LogTemp, Log, TEXT("[StreetManager] City graph generated (%d street entries)."), GeneratedGraph.Num());
 }
 
 UStreetDefinition* UStreetManager::ResolveExitDestination(UStreetDefinition* Street, FName ExitID) const
@@ -471,18 +1162,8 @@ UStreetDefinition* UStreetManager::ResolveExitDestination(UStreetDefinition* Str
 		return Link->Destination.Get();
 
 	// 2. Fall back to runtime graph
-	const TMap<FName, FName>* ExitMap = GeneratedGraph.Find(Street->StreetID);
-	if (ExitMap)
-	{
-		const FName* ToID = ExitMap->Find(ExitID);
-		if (ToID && !ToID->IsNone())
-		{
-			const TObjectPtr<UStreetDefinition>* Found = AllStreetDefsMap.Find(*ToID);
-			return Found ? Found->Get() : nullptr;
-		}
-	}
-
-	return nullptr;
+	const int32 Edge = StreetGraph.FindEdge(GetStreetIndex(Street), ExitID);
+	return Edge != INDEX_NONE ? GetStreetByIndex(StreetGraph.Edges[Edge].To) : nullptr;
 }
 
 bool UStreetManager::HasResolvableExit(FName ExitID) const
@@ -492,46 +1173,285 @@ bool UStreetManager::HasResolvableExit(FName ExitID) const
 
 UStreetDefinition* UStreetManager::FindStreetByID(FName StreetID) const
 {
-	const TObjectPtr<UStreetDefinition>* Found = AllStreetDefsMap.Find(StreetID);
-	return Found ? Found->Get() : nullptr;
+	UDefinitionCatalog* Catalog = GetCatalog();
+	return Catalog ? Catalog->FindStreet(StreetID) : nullptr;
+}
+
+int32 UStreetManager::GetStreetIndex(const UStreetDefinition* Street) const
+{
+	UDefinitionCatalog* Catalog = GetCatalog();
+	return (Catalog && Street) ? Catalog->GetStreetIndex(Street->StreetID) : INDEX_NONE;
+}
+
+UStreetDefinition* UStreetManager::GetStreetByIndex(int32 Index) const
+{
+	UDefinitionCatalog* Catalog = GetCatalog();
+	return Catalog ? Catalog->GetStreetByIndex(Index) : nullptr;
+}
+
+bool UStreetManager::FindRoute(UStreetDefinition* From, UStreetDefinition* To, EStreetRouteMetric Metric,
+	TArray<UStreetDefinition*>& OutStreets, TArray<FName>& OutExitIDs) const
+{
+	OutStreets.Reset();
+	OutExitIDs.Reset();
+
+	TArray<int32> RouteEdges;
+	if (!StreetGraph.FindRoute(GetStreetIndex(From), GetStreetIndex(To), Metric, RouteEdges))
+		return false;
+
+	for (int32 E : RouteEdges)
+	{
+		const FStreetGraphEdge& Edge = StreetGraph.Edges[E];
+		OutStreets.Add(GetStreetByIndex(Edge.To));
+		OutExitIDs.Add(Edge.ExitID);
+	}
+	return true;
+}
+
+void UStreetManager::RebuildStreetGraph()
+{
+	UDefinitionCatalog* Catalog = GetCatalog();
+	if (!Catalog)
+	{
+		StreetGraph.Reset();
+		return;
+	}
+
+	StreetGraph.Build(*Catalog, GeneratedGraph);
+	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Street graph: %d nodes, %d edges."),
+		StreetGraph.NumNodes(), StreetGraph.Edges.Num());
 }
 
 void UStreetManager::SaveGraphToSaveGame(UTwoDSurvivalSaveGame* Save) const
 {
 	if (!Save) return;
 
+	// The graph is a pure function of seed + catalog — no need to store its edges.
 	Save->bStreetGraphGenerated = bCityGenerated;
+	Save->StreetGraphSeed       = WorldSeed;
+	Save->StreetGraphVersion    = CityGraphVersion;
 	Save->SavedStreetGraph.Empty();
 
-	for (const auto& StreetKV : GeneratedGraph)
+	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Saved street graph seed %d (version %d)."), WorldSeed, CityGraphVersion);
+}
+
+void UStreetManager::RestoreGraphFromSaveGame(const UTwoDSurvivalSaveGame* Save)
+{
+	if (!Save || !Save->bStreetGraphGenerated) return;
+
+	// Ensure the catalog is built so ResolveExitDestination can look up defs by ID.
+	if (UDefinitionCatalog* Catalog = GetCatalog())
+		Catalog->EnsureReady();
+
+	// Legacy save (before seeded generation) — rebuild from the stored edges.
+	if (Save->StreetGraphVersion == 0)
 	{
-		for (const auto& ExitKV : StreetKV.Value)
+		GeneratedGraph.Empty();
+		for (const FSavedStreetConnection& Conn : Save->SavedStreetGraph)
 		{
-			FSavedStreetConnection Conn;
-			Conn.FromStreetID = StreetKV.Key;
-			Conn.ExitID       = ExitKV.Key;
-			Conn.ToStreetID   = ExitKV.Value;
-			Save->SavedStreetGraph.Add(Conn);
+			GeneratedGraph.FindOrAdd(Conn.FromStreetID).Add(Conn.ExitID, Conn.ToStreetID);
 		}
+		RebuildStreetGraph();
+
+		bCityGenerated = true;
+		UE_LOG(LogTemp, Log, TEXT("[StreetManager] Restored %d street graph connections from legacy save."),
+			Save->SavedStreetGraph.Num());
+		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Saved %d street graph connections."), Save->SavedStreetGraph.Num());
+	if (Save->StreetGraphVersion != CityGraphVersion)
+	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("[StreetManager] Save was made with city graph version %d (current %d) — layout will differ."),
+			Save->StreetGraphVersion, CityGraphVersion);
+	}
+
+	GenerateCityGraph(Save->StreetGraphSeed);
 }
 
-void UStreetManager::RestoreGraphFromSaveGame(const UTwoDSurvivalSaveGame* Save)
+// ─────────────────────────────────────────────────────────────────────────────
+// Console commands
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if !UE_BUILD_SHIPPING
+
+namespace
 {
-	if (!Save || !Save->bStreetGraphGenerated) return;
+	/**
+	 * TwoD.StreetTransitionStats [StreetID | reset]
+	 *
+	 * Prints p50/p95/max of each transition phase per destination street from the
+	 * UStreetManager ring buffer (last 256 transitions).
+	 */
+	void StreetTransitionStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+		UStreetManager* SM = GI ? GI->GetSubsystem<UStreetManager>() : nullptr;
+		if (!SM)
+		{
+			Ar.Log(TEXT("[StreetManager] No StreetManager in this world."));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			SM->GetTransitionTimeline().Reset();
+			Ar.Log(TEXT("[StreetManager] Transition timings cleared."));
+			return;
+		}
 
-	// Ensure the asset map is populated so ResolveExitDestination can look up defs by ID.
-	if (AllStreetDefsMap.IsEmpty())
-		ScanAllStreetDefs();
+		SM->GetTransitionTimeline().DumpStats(Ar, Args.Num() > 0 ? FName(*Args[0]) : NAME_None);
+	}
 
-	GeneratedGraph.Empty();
-	for (const FSavedStreetConnection& Conn : Save->SavedStreetGraph)
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice StreetTransitionStatsCommand(
+		TEXT("TwoD.StreetTransitionStats"),
+		TEXT("Prints p50/p95/max per street transition phase. Args: [StreetID | reset]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&StreetTransitionStats));
+
+	/**
+	 * TwoD.StreetStateStats
+	 *
+	 * Prints how many streets have saved state and how much memory the records use.
+	 */
+	void StreetStateStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
 	{
-		GeneratedGraph.FindOrAdd(Conn.FromStreetID).Add(Conn.ExitID, Conn.ToStreetID);
+		UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+		UStreetManager* SM = GI ? GI->GetSubsystem<UStreetManager>() : nullptr;
+		if (!SM)
+		{
+			Ar.Log(TEXT("[StreetManager] No StreetManager in this world."));
+			return;
+		}
+
+		SM->GetStreetStates().DumpStats(Ar);
 	}
 
-	bCityGenerated = true;
-	UE_LOG(LogTemp, Log, TEXT("[StreetManager] Restored %d street graph connections from save."), Save->SavedStreetGraph.Num());
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice StreetStateStatsCommand(
+		TEXT("TwoD.StreetStateStats"),
+		TEXT("Prints saved per-street state counts and memory use."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&StreetStateStats));
+}
+
+#endif // !UE_BUILD_SHIPPING
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Benchmark
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	int64 GetGraphAllocatedSize(const TMap<FName, TMap<FName, FName>>& Graph)
+	{
+		int64 Bytes = Graph.GetAllocatedSize();
+		for (const auto& KV : Graph)
+			Bytes += KV.Value.GetAllocatedSize();
+		return Bytes;
+	}
+
+	bool GraphsEqual(const TMap<FName, TMap<FName, FName>>& A, const TMap<FName, TMap<FName, FName>>& B)
+	{
+		if (A.Num() != B.Num()) return false;
+		for (const auto& KV : A)
+		{
+			const TMap<FName, FName>* Other = B.Find(KV.Key);
+			if (!Other || !KV.Value.OrderIndependentCompareEqual(*Other)) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * TwoD.BenchCityGraph [NumStreets=10000] [StreetsPerCity=50] [Seed=1] [Iterations=5]
+	 *
+	 * Builds a synthetic transient catalog (every street has one open Left and one open Right
+	 * exit), runs UStreetManager::BuildCityGraph on it and logs average time, the graph's heap
+	 * footprint and the process memory delta. Also re-runs the first seed to check determinism.
+	 */
+	void BenchCityGraph(const TArray<FString>& Args)
+	{
+		const int32 NumStreets     = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 StreetsPerCity = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 50;
+		const int32 Seed           = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1;
+		const int32 Iterations     = Args.Num() > 3 ? FMath::Max(1, FCString::Atoi(*Args[3])) : 5;
+
+		// ── Synthetic catalog ─────────────────────────────────────────────────
+		TArray<TStrongObjectPtr<UObject>> Keep;
+		TArray<TObjectPtr<UStreetDefinition>> Streets;
+		Streets.Reserve(NumStreets);
+
+		UCityDefinition* City = nullptr;
+		for (int32 i = 0; i < NumStreets; ++i)
+		{
+			if (i % StreetsPerCity == 0)
+			{
+				City = NewObject<UCityDefinition>(GetTransientPackage());
+				City->CityID     = FName(*FString::Printf(TEXT("BenchCity_%d"), i / StreetsPerCity));
+				City->MinStreets = StreetsPerCity;
+				City->MaxStreets = StreetsPerCity;
+				Keep.Emplace(City);
+			}
+
+			UStreetDefinition* Street = NewObject<UStreetDefinition>(GetTransientPackage());
+			Street->StreetID  = FName(*FString::Printf(TEXT("BenchStreet_%05d"), i));
+			Street->OwnerCity = City;
+
+			FStreetExitLink& Left = Street->Exits.AddDefaulted_GetRef();
+			Left.ExitID = FName("Left");
+			Left.Layout = EExitLayout::AdjacentLeft;
+
+			FStreetExitLink& Right = Street->Exits.AddDefaulted_GetRef();
+			Right.ExitID = FName("Right");
+			Right.Layout = EExitLayout::AdjacentRight;
+
+			Keep.Emplace(Street);
+			Streets.Add(Street);
+		}
+
+		// ── Timed runs ────────────────────────────────────────────────────────
+		TMap<FName, TMap<FName, FName>> Graph;
+		TMap<FName, TMap<FName, FName>> FirstGraph;
+
+		const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+		double TotalSeconds = 0.0;
+		double MaxSeconds   = 0.0;
+
+		for (int32 It = 0; It < Iterations; ++It)
+		{
+			const double Start = FPlatformTime::Seconds();
+			UStreetManager::BuildCityGraph(Streets, Seed + It, Graph);
+			const double Elapsed = FPlatformTime::Seconds() - Start;
+
+			TotalSeconds += Elapsed;
+			MaxSeconds    = FMath::Max(MaxSeconds, Elapsed);
+
+			if (It == 0)
+				FirstGraph = Graph;
+		}
+
+		const int64 UsedDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(UsedBefore);
+
+		// Same seed again must reproduce the first graph exactly.
+		UStreetManager::BuildCityGraph(Streets, Seed, Graph);
+		const bool bDeterministic = GraphsEqual(Graph, FirstGraph);
+
+		int32 NumEdges = 0;
+		for (const auto& KV : FirstGraph)
+			NumEdges += KV.Value.Num();
+
+		UE_LOG(LogTemp, Display,
+			TEXT("[StreetManager] BenchCityGraph: %d streets, %d per city, %d iterations — avg %.3f ms, max %.3f ms."),
+			NumStreets, StreetsPerCity, Iterations, TotalSeconds * 1000.0 / Iterations, MaxSeconds * 1000.0);
+		UE_LOG(LogTemp, Display,
+			TEXT("[StreetManager] BenchCityGraph: %d streets / %d directed edges, graph heap %.1f KB, process used-physical delta %.1f KB, deterministic: %s."),
+			FirstGraph.Num(), NumEdges, GetGraphAllocatedSize(FirstGraph) / 1024.0, UsedDelta / 1024.0,
+			bDeterministic ? TEXT("yes") : TEXT("NO"));
+	}
+
+	FAutoConsoleCommand BenchCityGraphCommand(
+		TEXT("TwoD.BenchCityGraph"),
+		TEXT("Benchmarks seeded city graph generation on a synthetic catalog. Args: [NumStreets=10000] [StreetsPerCity=50] [Seed=1] [Iterations=5]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchCityGraph));
 }
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,360 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/StreetStateStore.h"
+#include "World/DoorActor.h"
+#include "World/WorldItem.h"
+#include "World/WorldProp.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyPool.h"
+#include "Enemy/HordeManager.h"
+#include "Character/HealthComponent.h"
+#include "Interaction/BreakableComponent.h"
+#include "Inventory/ItemDefinition.h"
+#include "Data/DefinitionCatalog.h"
+#include "World/ActorSpatialIndex.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+namespace
+{
+	// Actors of type T in [MinX, MaxX) by their current location. Index keys can lag a refresh
+	// behind a moving actor, so the index query is padded and the span re-checked live.
+	template <typename T>
+	TArray<T*> GatherInSpan(UWorld* World, EActorIndexCategory Category, float MinX, float MaxX)
+	{
+		constexpr float KeyLagPadding = 500.f;
+
+		TArray<T*> Out;
+		auto Consider = [&Out, MinX, MaxX](AActor* Actor)
+		{
+			T* Typed = Cast<T>(Actor);
+			const float X = Actor->GetActorLocation().X;
+			if (Typed && !Actor->IsActorBeingDestroyed() && X >= MinX && X < MaxX)
+				Out.Add(Typed);
+		};
+
+		if (const UActorSpatialIndex* Index = World->GetSubsystem<UActorSpatialIndex>())
+		{
+			Index->ForEachInRange(Category, MinX - KeyLagPadding, MaxX + KeyLagPadding, Consider);
+		}
+		else
+		{
+			for (TActorIterator<T> It(World); It; ++It)
+				Consider(*It);
+		}
+		return Out;
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Capture
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FStreetStateStore::Capture(UWorld* World, FName StreetID, const FVector& Origin, float Width,
+	UDefinitionCatalog& Catalog)
+{
+	if (!World || StreetID.IsNone()) return;
+	if (LiveStreets.Remove(StreetID) == 0) return;
+
+	const float MinX = Origin.X;
+	const float MaxX = Origin.X + Width;
+
+	FStreetStateRecord Record;
+
+	// ── Horde ─────────────────────────────────────────────────────────────────
+	// First, so enemies promoted from the horde are demoted back into it, not saved as enemies.
+	if (UHordeManager* Horde = World->GetSubsystem<UHordeManager>())
+	{
+		TArray<FHordeMember> Members;
+		Horde->ExtractSpan(MinX, MaxX, Members);
+
+		Record.Horde.Reserve(Members.Num());
+		for (const FHordeMember& Member : Members)
+		{
+			const UClass* Class = Horde->GetMemberClass(Member.ClassIndex);
+			if (!Class) continue;
+
+			FSavedHordeMember& Saved = Record.Horde.AddDefaulted_GetRef();
+			Saved.LocalPosition = FVector3f(Member.Position - Origin);
+			Saved.LocalHomeX    = Member.HomeX - Origin.X;
+			Saved.LocalAlertX   = Member.AlertX - Origin.X;
+			Saved.BodyHealth    = Member.BodyHealth;
+			Saved.ClassIndex    = FindOrAddEnemyClass(Class);
+			Saved.State         = Member.State;
+			Saved.Dir           = Member.Dir;
+		}
+	}
+
+	// ── Enemies ───────────────────────────────────────────────────────────────
+	// Captured enemies go back to the pool, ready for the street the player is heading to.
+	UEnemyPool* Pool = World->GetSubsystem<UEnemyPool>();
+	for (AEnemyBase* Enemy : GatherInSpan<AEnemyBase>(World, EActorIndexCategory::Enemy, MinX, MaxX))
+	{
+		if (Enemy->IsInPool()) continue;
+
+		// Corpses finish their death timer off-screen — nothing to bring back.
+		if (Enemy->CurrentState != EEnemyState::Dead && !Enemy->HealthComp->IsDead())
+		{
+			FSavedEnemyState& Saved = Record.Enemies.AddDefaulted_GetRef();
+			Saved.LocalPosition = FVector3f(Enemy->GetActorLocation() - Origin);
+			Saved.Yaw           = Enemy->GetActorRotation().Yaw;
+			Saved.BodyHealth    = Enemy->HealthComp->GetBodyPart(EBodyPart::Body).CurrentHealth;
+			Saved.ClassIndex    = FindOrAddEnemyClass(Enemy->GetClass());
+			Saved.State         = Enemy->CurrentState;
+		}
+
+		if (Pool)
+			Pool->Release(Enemy);
+		else
+			Enemy->Destroy();
+	}
+
+	// ── Dropped items ─────────────────────────────────────────────────────────
+	for (AWorldItem* Item : GatherInSpan<AWorldItem>(World, EActorIndexCategory::Item, MinX, MaxX))
+	{
+		const int32 ItemIndex = Item->ItemDef ? Catalog.GetItemIndex(Item->ItemDef->ItemID) : INDEX_NONE;
+		if (ItemIndex != INDEX_NONE && Item->Quantity > 0)
+		{
+			FSavedItemState& Saved = Record.Items.AddDefaulted_GetRef();
+			Saved.LocalPosition = FVector3f(Item->GetActorLocation() - Origin);
+			Saved.ItemIndex     = ItemIndex;
+			Saved.Quantity      = Item->Quantity;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[StreetState] Dropping '%s' on '%s' — item is not in the catalog."),
+				*Item->GetName(), *StreetID.ToString());
+		}
+
+		Item->Destroy();
+	}
+
+	// ── Doors + breakables ────────────────────────────────────────────────────
+	for (ADoorActor* Door : GatherInSpan<ADoorActor>(World, EActorIndexCategory::Interactable, MinX, MaxX))
+	{
+		if (Door->IsOpen() == Door->bStartOpen) continue;
+
+		Record.Props.Add({ MakePropCell(Door->GetActorLocation() - Origin),
+			Door->IsOpen() ? ESavedPropFlags::DoorOpen : ESavedPropFlags::None });
+	}
+
+	TArray<TPair<TWeakObjectPtr<AWorldProp>, FIntVector>> Breakables;
+	TrackedBreakables.RemoveAndCopyValue(StreetID, Breakables);
+	for (const TPair<TWeakObjectPtr<AWorldProp>, FIntVector>& Tracked : Breakables)
+	{
+		AWorldProp* Prop = Tracked.Key.Get();
+		if (!Prop || Prop->IsActorBeingDestroyed())
+		{
+			Record.Props.Add({ Tracked.Value, ESavedPropFlags::Destroyed });
+			continue;
+		}
+
+		const UBreakableComponent* Breakable = Prop->FindComponentByClass<UBreakableComponent>();
+		if (Breakable && Breakable->IsBroken())
+			Record.Props.Add({ Tracked.Value, ESavedPropFlags::Broken });
+	}
+
+	Record.Enemies.Shrink();
+	Record.Items.Shrink();
+	Record.Props.Shrink();
+	Record.Horde.Shrink();
+
+	UE_LOG(LogTemp, Log, TEXT("[StreetState] Captured '%s': %d enemies, %d horde, %d items, %d props (%llu bytes)."),
+		*StreetID.ToString(), Record.Enemies.Num(), Record.Horde.Num(), Record.Items.Num(), Record.Props.Num(),
+		static_cast<uint64>(Record.GetAllocatedSize()));
+
+	Records.Add(StreetID, MoveTemp(Record));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Restore
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FStreetStateStore::Restore(UWorld* World, FName StreetID, const FVector& Origin, float Width,
+	UDefinitionCatalog& Catalog)
+{
+	if (!World || StreetID.IsNone()) return;
+	if (LiveStreets.Contains(StreetID)) return;
+	LiveStreets.Add(StreetID);
+
+	const float MinX = Origin.X;
+	const float MaxX = Origin.X + Width;
+
+	FStreetStateRecord* Record = Records.Find(StreetID);
+
+	// ── Doors + breakables ────────────────────────────────────────────────────
+	TMap<FIntVector, ESavedPropFlags> PropFlags;
+	if (Record)
+	{
+		PropFlags.Reserve(Record->Props.Num());
+		for (const FSavedPropState& Saved : Record->Props)
+			PropFlags.Add(Saved.Cell, Saved.Flags);
+	}
+
+	if (PropFlags.Num() > 0)
+	{
+		for (ADoorActor* Door : GatherInSpan<ADoorActor>(World, EActorIndexCategory::Interactable, MinX, MaxX))
+		{
+			if (const ESavedPropFlags* Flags = PropFlags.Find(MakePropCell(Door->GetActorLocation() - Origin)))
+				Door->SetOpen(EnumHasAnyFlags(*Flags, ESavedPropFlags::DoorOpen));
+		}
+	}
+
+	TArray<TPair<TWeakObjectPtr<AWorldProp>, FIntVector>>& Breakables = TrackedBreakables.Add(StreetID);
+	for (AWorldProp* Prop : GatherInSpan<AWorldProp>(World, EActorIndexCategory::Interactable, MinX, MaxX))
+	{
+		UBreakableComponent* Breakable = Prop->FindComponentByClass<UBreakableComponent>();
+		if (!Breakable) continue;
+
+		const FIntVector Cell = MakePropCell(Prop->GetActorLocation() - Origin);
+		const ESavedPropFlags* Flags = PropFlags.Find(Cell);
+		if (Flags && EnumHasAnyFlags(*Flags, ESavedPropFlags::Broken | ESavedPropFlags::Destroyed))
+		{
+			Breakable->RestoreBroken();
+			if (!IsValid(Prop))
+			{
+				Breakables.Emplace(nullptr, Cell);
+				continue;
+			}
+		}
+
+		Breakables.Emplace(Prop, Cell);
+	}
+
+	if (!Record) return;
+
+	// ── Enemies + items ───────────────────────────────────────────────────────
+	// The record is authoritative: anything level-placed in the span is replaced by it.
+	UEnemyPool* Pool = World->GetSubsystem<UEnemyPool>();
+	for (AEnemyBase* Enemy : GatherInSpan<AEnemyBase>(World, EActorIndexCategory::Enemy, MinX, MaxX))
+	{
+		if (Pool)
+			Pool->Release(Enemy);
+		else
+			Enemy->Destroy();
+	}
+	for (AWorldItem* Item : GatherInSpan<AWorldItem>(World, EActorIndexCategory::Item, MinX, MaxX))
+	{
+		Item->Destroy();
+	}
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	int32 Restored = 0;
+	for (const FSavedEnemyState& Saved : Record->Enemies)
+	{
+		UClass* EnemyClass = EnemyClasses.IsValidIndex(Saved.ClassIndex)
+			? EnemyClasses[Saved.ClassIndex].TryLoadClass<AEnemyBase>() : nullptr;
+		if (!EnemyClass) continue;
+
+		const FVector Location = Origin + FVector(Saved.LocalPosition);
+		const FRotator Rotation(0.f, Saved.Yaw, 0.f);
+		AEnemyBase* Enemy = Pool ? Pool->Acquire(EnemyClass, Location, Rotation)
+			: World->SpawnActor<AEnemyBase>(EnemyClass, Location, Rotation, Params);
+		if (!Enemy) continue;
+
+		Enemy->RestoreSavedState(Saved.BodyHealth, Saved.State);
+		++Restored;
+	}
+
+	UHordeManager* Horde = World->GetSubsystem<UHordeManager>();
+	if (Horde && Record->Horde.Num() > 0)
+	{
+		TArray<FHordeMember> Members;
+		Members.Reserve(Record->Horde.Num());
+		for (const FSavedHordeMember& Saved : Record->Horde)
+		{
+			UClass* EnemyClass = EnemyClasses.IsValidIndex(Saved.ClassIndex)
+				? EnemyClasses[Saved.ClassIndex].TryLoadClass<AEnemyBase>() : nullptr;
+			if (!EnemyClass) continue;
+
+			FHordeMember& Member = Members.AddDefaulted_GetRef();
+			Member.Position   = Origin + FVector(Saved.LocalPosition);
+			Member.HomeX      = Origin.X + Saved.LocalHomeX;
+			Member.AlertX     = Origin.X + Saved.LocalAlertX;
+			Member.BodyHealth = Saved.BodyHealth;
+			Member.ClassIndex = Horde->FindOrAddClass(EnemyClass);
+			Member.State      = Saved.State;
+			Member.Dir        = Saved.Dir;
+		}
+		Horde->AddMembers(Members);
+	}
+
+	for (const FSavedItemState& Saved : Record->Items)
+	{
+		UItemDefinition* Def = Catalog.GetItemByIndex(Saved.ItemIndex);
+		if (!Def) continue;
+
+		AWorldItem* Item = World->SpawnActor<AWorldItem>(AWorldItem::StaticClass(),
+			FTransform(FRotator::ZeroRotator, Origin + FVector(Saved.LocalPosition)));
+		if (Item)
+		{
+			Item->ItemDef  = Def;
+			Item->Quantity = Saved.Quantity;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[StreetState] Restored '%s': %d/%d enemies, %d horde, %d items, %d props."),
+		*StreetID.ToString(), Restored, Record->Enemies.Num(), Record->Horde.Num(), Record->Items.Num(),
+		Record->Props.Num());
+
+	// Live actors own this state until the next Capture(). The (empty) record stays so the
+	// street's spawn points keep treating it as already populated.
+	Record->Enemies.Empty();
+	Record->Horde.Empty();
+	Record->Items.Empty();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Bookkeeping
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FStreetStateStore::Reset()
+{
+	Records.Empty();
+	EnemyClasses.Empty();
+	LiveStreets.Empty();
+	TrackedBreakables.Empty();
+}
+
+SIZE_T FStreetStateStore::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Records.GetAllocatedSize() + EnemyClasses.GetAllocatedSize()
+		+ LiveStreets.GetAllocatedSize() + TrackedBreakables.GetAllocatedSize();
+	for (const TPair<FName, FStreetStateRecord>& Pair : Records)
+		Bytes += Pair.Value.GetAllocatedSize();
+	return Bytes;
+}
+
+void FStreetStateStore::DumpStats(FOutputDevice& Ar) const
+{
+	int32 Enemies = 0, Horde = 0, Items = 0, Props = 0;
+	for (const TPair<FName, FStreetStateRecord>& Pair : Records)
+	{
+		Enemies += Pair.Value.Enemies.Num();
+		Horde   += Pair.Value.Horde.Num();
+		Items   += Pair.Value.Items.Num();
+		Props   += Pair.Value.Props.Num();
+	}
+
+	Ar.Logf(TEXT("[StreetState] %d streets: %d enemies, %d horde, %d items, %d props, %d enemy classes — %.1f KB."),
+		Records.Num(), Enemies, Horde, Items, Props, EnemyClasses.Num(), GetAllocatedSize() / 1024.0);
+}
+
+uint16 FStreetStateStore::FindOrAddEnemyClass(const UClass* Class)
+{
+	const FSoftClassPath ClassPath(Class);
+	int32 ClassIndex = EnemyClasses.IndexOfByKey(ClassPath);
+	if (ClassIndex == INDEX_NONE)
+		ClassIndex = EnemyClasses.Add(ClassPath);
+	return static_cast<uint16>(ClassIndex);
+}
+
+FIntVector FStreetStateStore::MakePropCell(const FVector& LocalPosition)
+{
+	return FIntVector(
+		FMath::RoundToInt(LocalPosition.X / 10.0),
+		FMath::RoundToInt(LocalPosition.Y / 10.0),
+		FMath::RoundToInt(LocalPosition.Z / 10.0));
+}
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/StreetTransitionTimeline.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Misc/OutputDevice.h"
+
+UE_TRACE_CHANNEL_DEFINE(StreetTransitionChannel);
+
+namespace
+{
+	constexpr int32 NumPhases = static_cast<int32>(EStreetTransitionPhase::Count);
+
+	const TCHAR* const RegionNames[NumPhases] =
+	{
+		TEXT("StreetTransition.Request"),
+		TEXT("StreetTransition.Load"),
+		TEXT("StreetTransition.Show"),
+		TEXT("StreetTransition.Teleport"),
+		TEXT("StreetTransition.Prefetch"),
+		TEXT("StreetTransition.Broadcast"),
+	};
+
+	// Nearest-rank percentile on a sorted array.
+	float Percentile(const TArray<float>& Sorted, float P)
+	{
+		if (Sorted.IsEmpty()) return 0.f;
+		const int32 Idx = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Idx];
+	}
+}
+
+const TCHAR* FStreetTransitionTimeline::GetPhaseName(EStreetTransitionPhase Phase)
+{
+	switch (Phase)
+	{
+	case EStreetTransitionPhase::Request:   return TEXT("Request");
+	case EStreetTransitionPhase::Load:      return TEXT("Load");
+	case EStreetTransitionPhase::Show:      return TEXT("Show");
+	case EStreetTransitionPhase::Teleport:  return TEXT("Teleport");
+	case EStreetTransitionPhase::Prefetch:  return TEXT("Prefetch");
+	case EStreetTransitionPhase::Broadcast: return TEXT("Broadcast");
+	default:                                return TEXT("?");
+	}
+}
+
+void FStreetTransitionTimeline::Begin(FName StreetID)
+{
+	if (bActive)
+		Cancel();
+
+	Current          = FStreetTransitionRecord();
+	Current.StreetID = StreetID;
+	StartTime        = FPlatformTime::Seconds();
+	LastMarkTime     = StartTime;
+	bActive          = true;
+
+	BeginPhaseRegion(0);
+}
+
+void FStreetTransitionTimeline::MarkPhaseEnd(EStreetTransitionPhase Phase)
+{
+	if (!bActive) return;
+
+	const double Now = FPlatformTime::Seconds();
+	const int32 PhaseIdx = static_cast<int32>(Phase);
+	Current.PhaseMs[PhaseIdx] += static_cast<float>((Now - LastMarkTime) * 1000.0);
+	LastMarkTime = Now;
+
+	EndPhaseRegion();
+	if (PhaseIdx + 1 < NumPhases)
+		BeginPhaseRegion(PhaseIdx + 1);
+}
+
+void FStreetTransitionTimeline::End()
+{
+	if (!bActive) return;
+
+	EndPhaseRegion();
+
+	Current.TotalMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	bActive = false;
+
+	if (Ring.Num() < Capacity)
+	{
+		Ring.Add(Current);
+	}
+	else
+	{
+		Ring[NextSlot] = Current;
+	}
+	NextSlot = (NextSlot + 1) % Capacity;
+}
+
+void FStreetTransitionTimeline::Cancel()
+{
+	if (!bActive) return;
+
+	EndPhaseRegion();
+	bActive = false;
+}
+
+void FStreetTransitionTimeline::Reset()
+{
+	Cancel();
+	Ring.Reset();
+	NextSlot = 0;
+}
+
+void FStreetTransitionTimeline::BeginPhaseRegion(int32 Phase)
+{
+	OpenRegion = INDEX_NONE;
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(StreetTransitionChannel))
+	{
+		TRACE_BEGIN_REGION(RegionNames[Phase]);
+		OpenRegion = Phase;
+	}
+}
+
+void FStreetTransitionTimeline::EndPhaseRegion()
+{
+	if (OpenRegion != INDEX_NONE)
+	{
+		TRACE_END_REGION(RegionNames[OpenRegion]);
+		OpenRegion = INDEX_NONE;
+	}
+}
+
+void FStreetTransitionTimeline::DumpStats(FOutputDevice& Ar, FName Filter) const
+{
+	// Group records by destination street.
+	TMap<FName, TArray<const FStreetTransitionRecord*>> ByStreet;
+	for (const FStreetTransitionRecord& Record : Ring)
+	{
+		if (!Filter.IsNone() && Record.StreetID != Filter) continue;
+		ByStreet.FindOrAdd(Record.StreetID).Add(&Record);
+	}
+
+	if (ByStreet.IsEmpty())
+	{
+		Ar.Logf(TEXT("[StreetManager] No street transitions recorded%s."),
+			Filter.IsNone() ? TEXT("") : *FString::Printf(TEXT(" for '%s'"), *Filter.ToString()));
+		return;
+	}
+
+	ByStreet.KeySort(FNameLexicalLess());
+
+	TArray<float> Samples;
+	for (const auto& KV : ByStreet)
+	{
+		int32 NumResident = 0;
+		for (const FStreetTransitionRecord* R : KV.Value)
+			NumResident += R->bResident ? 1 : 0;
+
+		Ar.Logf(TEXT("[StreetManager] '%s' — %d transition(s), %d resident hit(s). ms: p50 / p95 / max"),
+			*KV.Key.ToString(), KV.Value.Num(), NumResident);
+
+		for (int32 Phase = 0; Phase <= NumPhases; ++Phase)
+		{
+			Samples.Reset();
+			for (const FStreetTransitionRecord* R : KV.Value)
+				Samples.Add(Phase < NumPhases ? R->PhaseMs[Phase] : R->TotalMs);
+			Samples.Sort();
+
+			Ar.Logf(TEXT("    %-10s %8.2f %8.2f %8.2f"),
+				Phase < NumPhases ? GetPhaseName(static_cast<EStreetTransitionPhase>(Phase)) : TEXT("Total"),
+				Percentile(Samples, 0.5f), Percentile(Samples, 0.95f), Samples.Last());
+		}
+	}
+}
@@ -2,8 +2,13 @@
 
 #include "World/WorldEventManager.h"
 #include "World/WorldEventSpawnPoint.h"
+#include "World/StreetManager.h"
+#include "World/LevelMarkerIndex.h"
+#include "Engine/GameInstance.h"
 #include "World/TimeManager.h"
 #include "World/NPCActor.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyPool.h"
 #include "World/WorldItem.h"
 #include "Character/BaseCharacter.h"
 #include "Kismet/GameplayStatics.h"
@@ -43,6 +48,18 @@ void AWorldEventManager::BeginPlay()
 			TEXT("[WorldEventManager] No ATimeManager found in the world — events will not fire."));
 	}
 
+	// Have a full raid of each raid enemy class parked before the first night.
+	if (UEnemyPool* Pool = GetWorld()->GetSubsystem<UEnemyPool>())
+	{
+		for (const FWorldEvent& Event : EventTable)
+		{
+			if (Event.EventType == EWorldEventType::ScavengerRaid
+				&& Event.EnemyClass && Event.EnemyClass->IsChildOf<AEnemyBase>())
+			{
+				Pool->WarmUp(Event.EnemyClass.Get(), FMath::Max(Event.MinEnemies, Event.MaxEnemies));
+			}
+		}
+	}
 }
 
 // ── Day/night callback ────────────────────────────────────────────────────────
@@ -76,15 +93,28 @@ void AWorldEventManager::RollEvents()
 		return;
 	}
 
-	// Rescan spawn points now so we pick up actors from whichever sublevel is currently loaded.
+	// Take spawn points from whichever sublevel is current. UStreetManager indexes them when
+	// the level is shown; fall back to a world scan on maps that don't use street streaming.
 	SpawnPoints.Reset();
-	TArray<AActor*> FoundPoints;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AWorldEventSpawnPoint::StaticClass(), FoundPoints);
-	for (AActor* A : FoundPoints)
+	UStreetManager* SM = GetGameInstance() ? GetGameInstance()->GetSubsystem<UStreetManager>() : nullptr;
+	if (const FLevelMarkerIndex* Markers = SM ? SM->GetActiveMarkers() : nullptr)
+	{
+		for (const TWeakObjectPtr<AWorldEventSpawnPoint>& SP : Markers->WorldEventSpawnPoints)
+		{
+			if (SP.IsValid())
+				SpawnPoints.Add(SP.Get());
+		}
+	}
+	else
 	{
-		if (AWorldEventSpawnPoint* SP = Cast<AWorldEventSpawnPoint>(A))
+		TArray<AActor*> FoundPoints;
+		UGameplayStatics::GetAllActorsOfClass(GetWorld(), AWorldEventSpawnPoint::StaticClass(), FoundPoints);
+		for (AActor* A : FoundPoints)
 		{
-			SpawnPoints.Add(SP);
+			if (AWorldEventSpawnPoint* SP = Cast<AWorldEventSpawnPoint>(A))
+			{
+				SpawnPoints.Add(SP);
+			}
 		}
 	}
 	UE_LOG(LogTemp, Log, TEXT("[WorldEventManager] %d spawn point(s) available for this night."), SpawnPoints.Num());
@@ -222,11 +252,17 @@ void AWorldEventManager::SpawnScavengerRaid(const FWorldEvent& Event, ABaseChara
 	Params.SpawnCollisionHandlingOverride =
 		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
+	// AEnemyBase raiders come out of the pool (warmed in BeginPlay).
+	UEnemyPool* Pool = Event.EnemyClass->IsChildOf<AEnemyBase>() ? GetWorld()->GetSubsystem<UEnemyPool>() : nullptr;
+
 	int32 Spawned = 0;
 	for (int32 i = 0; i < Count; ++i)
 	{
 		const FVector SpawnLoc = GetSpawnLocation(Player->GetActorLocation());
-		if (GetWorld()->SpawnActor<ACharacter>(Event.EnemyClass, SpawnLoc, FRotator::ZeroRotator, Params))
+		ACharacter* Enemy = Pool
+			? Pool->Acquire(Event.EnemyClass.Get(), SpawnLoc, FRotator::ZeroRotator)
+			: GetWorld()->SpawnActor<ACharacter>(Event.EnemyClass, SpawnLoc, FRotator::ZeroRotator, Params);
+		if (Enemy)
 		{
 			++Spawned;
 		}
@@ -1,6 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "World/WorldEventSpawnPoint.h"
+#include "World/StreetManager.h"
+#include "Enemy/EnemyBase.h"
+#include "Enemy/EnemyPool.h"
+#include "Engine/GameInstance.h"
 
 #if WITH_EDITOR
 #include "Components/ArrowComponent.h"
@@ -32,6 +36,15 @@ void AWorldEventSpawnPoint::BeginPlay()
 	Super::BeginPlay();
 
 	if (SpawnPool.IsEmpty()) return;
+
+	// Street was visited before — UStreetManager restores its saved enemies instead.
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UStreetManager* SM = GI->GetSubsystem<UStreetManager>())
+		{
+			if (SM->ShouldSuppressLevelSpawns(GetLevel())) return;
+		}
+	}
 	if (FMath::FRand() > SpawnChance) return;
 
 	// Pick a random class from the pool.
@@ -42,7 +55,17 @@ void AWorldEventSpawnPoint::BeginPlay()
 	FActorSpawnParameters Params;
 	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	AActor* Spawned = GetWorld()->SpawnActor<AActor>(ChosenClass, GetActorLocation(), GetActorRotation(), Params);
+	// Enemies come out of the pool; anything else is spawned fresh.
+	AActor* Spawned = nullptr;
+	UEnemyPool* Pool = GetWorld()->GetSubsystem<UEnemyPool>();
+	if (Pool && ChosenClass->IsChildOf<AEnemyBase>())
+	{
+		Spawned = Pool->Acquire(ChosenClass.Get(), GetActorLocation(), GetActorRotation());
+	}
+	else
+	{
+		Spawned = GetWorld()->SpawnActor<AActor>(ChosenClass, GetActorLocation(), GetActorRotation(), Params);
+	}
 	if (Spawned)
 	{
 		UE_LOG(LogTemp, Log, TEXT("[SpawnPoint] '%s' spawned %s."), *SpawnPointID.ToString(), *ChosenClass->GetName());
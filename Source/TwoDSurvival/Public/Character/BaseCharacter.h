@@ -555,10 +555,7 @@ public:
 	virtual void CloseDialogue_Implementation();
 
 private:
-	// Maps ItemID → ItemDefinition for fast lookup during load. Built in BeginPlay via AssetRegistry scan.
-	UPROPERTY()
-	TMap<FName, UItemDefinition*> ItemDefMap;
-
+	// ItemID → ItemDefinition via UDefinitionCatalog. Used during load.
 	UItemDefinition* FindItemDefByID(FName ItemID) const;
 
 	// Bound to HealthComponent->OnBodyPartDamaged.
@@ -673,9 +670,6 @@ private:
 	UFUNCTION()
 	void OnStatusEffectsChanged();
 
-	/** Scans all UItemDefinition assets via AssetRegistry and builds ItemDefMap. */
-	void ScanItemDefinitions();
-
 	// Dynamic material instances for all slots on the character mesh.
 	// Created in BeginPlay so we can push the CharacterForward parameter each tick.
 	UPROPERTY()
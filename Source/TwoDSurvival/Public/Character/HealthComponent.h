@@ -73,6 +73,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Health")
 	void SetBodyPartHealth(EBodyPart Part, float NewCurrentHealth);
 
+	// Restores every body part to MaxHealth. Used when a pooled enemy is reused.
+	void ResetHealth();
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -28,12 +28,14 @@ class TWODSURVIVAL_API UNoiseEmitterComponent : public UActorComponent
 public:
 	UNoiseEmitterComponent();
 
-	// Emit a noise at the owning actor's location. Finds all AEnemyBase within the noise radius.
+	// Emit a noise at the owning actor's location. Queued on UEnemyAIManager, which alerts the
+	// enemies within the noise radius (muffled by closed doors and floors) at its next update.
 	UFUNCTION(BlueprintCallable, Category = "Noise")
 	void EmitNoise(ENoiseType Type, float RadiusOverride = 0.f);
 
 	// Emit a noise at an arbitrary world position. Use for doors, item pickups, explosions, etc.
-	// Safe to call from any actor — does not require a NoiseEmitterComponent owner.
+	// Safe to call from any actor — does not require a NoiseEmitterComponent owner. Queued, and
+	// merged with other noises at the same spot this frame.
 	static void BroadcastNoiseAt(UWorld* World, FVector Origin, float Radius);
 
 	// Tick helper: called from BaseCharacter::Tick to emit throttled footstep noise.
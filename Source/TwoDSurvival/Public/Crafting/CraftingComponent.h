@@ -9,12 +9,13 @@
 class UCraftingRecipe;
 class UInventoryComponent;
 class UItemDefinition;
+class UDefinitionCatalog;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCraftingChanged);
 
 /**
  * Manages crafting for the owning character.
- * Auto-scans all UCraftingRecipe and UItemDefinition assets via AssetRegistry in BeginPlay.
+ * Pulls all UCraftingRecipe and UItemDefinition assets from UDefinitionCatalog.
  * Attach to ABaseCharacter — toggle the crafting UI with the C key.
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -29,7 +30,7 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Crafting")
 	FOnCraftingChanged OnCraftingChanged;
 
-	// All recipes discovered via AssetRegistry scan in BeginPlay.
+	// All recipes from UDefinitionCatalog, sorted by RecipeID. Filled in BeginPlay.
 	UPROPERTY(BlueprintReadOnly, Category = "Crafting")
 	TArray<UCraftingRecipe*> AllRecipes;
 
@@ -66,9 +67,7 @@ protected:
 	virtual void BeginPlay() override;
 
 private:
-	// ItemID → ItemDefinition map, built in BeginPlay.
-	UPROPERTY()
-	TMap<FName, UItemDefinition*> ItemDefMap;
+	UDefinitionCatalog* GetCatalog() const;
 
-	void ScanAssets();
+	void CacheRecipes();
 };
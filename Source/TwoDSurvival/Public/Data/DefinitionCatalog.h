@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "DefinitionCatalog.generated.h"
+
+class UItemDefinition;
+class UCraftingRecipe;
+class UStreetDefinition;
+class UCityDefinition;
+struct FStreamableHandle;
+
+// Fired once when every definition asset has been loaded and indexed.
+DECLARE_MULTICAST_DELEGATE(FOnDefinitionCatalogReady);
+
+/**
+ * Single session-wide registry of every item, recipe, street and city data asset.
+ *
+ * Built once per game instance: one AssetRegistry query per class, then one async
+ * streamable load for all of them (deferred until the registry finishes its initial
+ * scan in the editor). Each table is sorted by ID, so a definition's dense index is
+ * stable for a given asset set and can be used in flat arrays / save data instead of
+ * hashing the FName every time.
+ *
+ * Lookups made before the async load finishes block on it via EnsureReady() —
+ * the same cost the old per-system synchronous scans paid, but paid only once.
+ *
+ * Access: GetGameInstance()->GetSubsystem<UDefinitionCatalog>()
+ */
+UCLASS()
+class TWODSURVIVAL_API UDefinitionCatalog : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** True once all definitions are loaded and indexed. */
+	bool IsReady() const { return bReady; }
+
+	/** Blocks until the catalog is built. No-op when already ready. */
+	void EnsureReady();
+
+	/** Broadcast when the async build completes. Bind before Initialize returns or check IsReady() first. */
+	FOnDefinitionCatalogReady OnCatalogReady;
+
+	// ── Items ─────────────────────────────────────────────────────────────────
+	UFUNCTION(BlueprintCallable, Category = "Catalog")
+	UItemDefinition* FindItem(FName ItemID);
+
+	/** Dense index of ItemID in GetItems(), or INDEX_NONE. */
+	int32 GetItemIndex(FName ItemID);
+
+	UItemDefinition* GetItemByIndex(int32 Index) { EnsureReady(); return Items.IsValidIndex(Index) ? Items[Index].Get() : nullptr; }
+	const TArray<TObjectPtr<UItemDefinition>>& GetItems() { EnsureReady(); return Items; }
+
+	// ── Recipes ───────────────────────────────────────────────────────────────
+	UFUNCTION(BlueprintCallable, Category = "Catalog")
+	UCraftingRecipe* FindRecipe(FName RecipeID);
+
+	int32 GetRecipeIndex(FName RecipeID);
+
+	UCraftingRecipe* GetRecipeByIndex(int32 Index) { EnsureReady(); return Recipes.IsValidIndex(Index) ? Recipes[Index].Get() : nullptr; }
+	const TArray<TObjectPtr<UCraftingRecipe>>& GetRecipes() { EnsureReady(); return Recipes; }
+
+	// ── Streets ───────────────────────────────────────────────────────────────
+	UFUNCTION(BlueprintCallable, Category = "Catalog")
+	UStreetDefinition* FindStreet(FName StreetID);
+
+	int32 GetStreetIndex(FName StreetID);
+
+	UStreetDefinition* GetStreetByIndex(int32 Index) { EnsureReady(); return Streets.IsValidIndex(Index) ? Streets[Index].Get() : nullptr; }
+	const TArray<TObjectPtr<UStreetDefinition>>& GetStreets() { EnsureReady(); return Streets; }
+
+	// ── Cities ────────────────────────────────────────────────────────────────
+	UFUNCTION(BlueprintCallable, Category = "Catalog")
+	UCityDefinition* FindCity(FName CityID);
+
+	int32 GetCityIndex(FName CityID);
+
+	UCityDefinition* GetCityByIndex(int32 Index) { EnsureReady(); return Cities.IsValidIndex(Index) ? Cities[Index].Get() : nullptr; }
+	const TArray<TObjectPtr<UCityDefinition>>& GetCities() { EnsureReady(); return Cities; }
+
+private:
+	// Sorted by ID — array position is the dense index.
+	UPROPERTY()
+	TArray<TObjectPtr<UItemDefinition>> Items;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UCraftingRecipe>> Recipes;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UStreetDefinition>> Streets;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UCityDefinition>> Cities;
+
+	// ID → dense index into the arrays above.
+	TMap<FName, int32> ItemIndexByID;
+	TMap<FName, int32> RecipeIndexByID;
+	TMap<FName, int32> StreetIndexByID;
+	TMap<FName, int32> CityIndexByID;
+
+	// Asset paths gathered from the AssetRegistry, resolved into the tables once loaded.
+	TArray<FSoftObjectPath> ItemPaths;
+	TArray<FSoftObjectPath> RecipePaths;
+	TArray<FSoftObjectPath> StreetPaths;
+	TArray<FSoftObjectPath> CityPaths;
+
+	TSharedPtr<FStreamableHandle> LoadHandle;
+	FDelegateHandle FilesLoadedHandle;
+
+	bool bLoadStarted = false;
+	bool bReady       = false;
+
+	/** Queries the AssetRegistry and kicks off the async load. */
+	void StartLoad();
+
+	/** Streamable completion callback — resolves paths into the sorted tables. */
+	void BuildTables();
+};
@@ -0,0 +1,502 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Enemy/EnemyTypes.h"
+#include "Enemy/ScentField.h"
+#include "EnemyAIManager.generated.h"
+
+class AEnemyBase;
+class ABaseCharacter;
+class AFlashlightActor;
+class ABuildingGenerator;
+struct FOcclusionSpans;
+
+// ── Significance ──────────────────────────────────────────────────────────────
+
+/**
+ * Tick LOD bucket, most significant first. Scored from distance to the player, whether the
+ * enemy was recently rendered, and whether it shares the player's building floor.
+ * On-screen and Alert enemies are never below Near.
+ */
+enum class EEnemySignificance : uint8
+{
+	Critical,	// Engaged (Chase/Attack) or within CriticalDistance.
+	Near,
+	Far,		// Also: off-screen on another floor / in or out of a building the player isn't.
+	Dormant,
+	Num
+};
+
+/**
+ * Tick intervals (seconds, 0 = every frame) and animation update rates applied to an enemy
+ * while it is in one bucket.
+ */
+USTRUCT()
+struct FEnemySignificanceTick
+{
+	GENERATED_BODY()
+
+	// Batched state machine decide rate.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float AIInterval = 0.f;
+
+	// UCharacterMovementComponent tick interval.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float MovementInterval = 0.f;
+
+	// Skeletal mesh (animation) tick interval.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float AnimationInterval = 0.f;
+
+	// What the mesh still does while off screen. OnlyTickMontagesWhenNotRendered skips pose
+	// evaluation but keeps montages and their notifies on time.
+	UPROPERTY(EditAnywhere)
+	EVisibilityBasedAnimTickOption VisibilityTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+
+	// URO: evaluate the pose every N ticks while on screen, whatever the mesh LOD.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1"))
+	int32 AnimEvalRate = 1;
+
+	// URO: evaluate every N ticks while off screen (when VisibilityTickOption still ticks the pose).
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1"))
+	int32 NonRenderedAnimEvalRate = 4;
+
+	// Blend the bones between evaluations instead of holding the last pose.
+	UPROPERTY(EditAnywhere)
+	bool bInterpolateSkippedFrames = true;
+};
+
+// ── Per-enemy bits ────────────────────────────────────────────────────────────
+
+enum class EEnemyAIFlags : uint16
+{
+	None           = 0,
+	ReachedAlert   = 1 << 0,	// Standing at AlertX, counting down AlertInvestigateTime.
+	Wake           = 1 << 5,	// Decide next frame regardless of the bucket's AIInterval.
+	PlayerNearby   = 1 << 6,	// Player within reach of any detection range this frame (UActorSpatialIndex).
+	HasTarget      = 1 << 7,	// Targets entry resolved this frame — its position is in TargetLocations.
+	Detour         = 1 << 8,	// Goal is in another room of a building — steer for DetourLocations instead.
+	Climb          = 1 << 9,	// That next room is up or down the stairs the enemy stands in.
+
+	// Gathered from the actor's combat state at the start of every update.
+	CanAttack      = 1 << 1,
+	Attacking      = 1 << 2,
+	MoveLocked     = 1 << 3,
+	RotationLocked = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EEnemyAIFlags);
+
+/** Side effects the decide pass asks the write-back pass to apply to one actor. */
+enum class EEnemyAIAction : uint8
+{
+	None        = 0,
+	Move        = 1 << 0,	// AddMovementInput along MoveDirs at MoveSpeeds. Held between decides.
+	Stop        = 1 << 1,	// StopMovementImmediately.
+	BeginAttack = 1 << 2,
+	TargetPlayer = 1 << 3,	// Spotted the player — Targets entry becomes the player.
+	DropTarget  = 1 << 4,	// Lost or out of range — Targets entry cleared.
+	Climb       = 1 << 5,	// Take the stairs — moved onto the floor of its DetourLocations entry.
+};
+ENUM_CLASS_FLAGS(EEnemyAIAction);
+
+/**
+ * Everything the decide pass reads that isn't per-slot, copied on the game thread before it
+ * runs. Decide never touches a UObject, so it can run on worker threads.
+ */
+struct FEnemyAIFrameSnapshot
+{
+	bool bHasPlayer = false;
+	FVector PlayerLocation = FVector::ZeroVector;
+
+	// World time — scent ages are measured against it.
+	float Time = 0.f;
+
+	// UOcclusionSpanCache's walls, slabs and closed doors. Null = nothing blocks sight.
+	const FOcclusionSpans* Occlusion = nullptr;
+
+	// Player's flashlight cone (AFlashlightActor::GetCone), if it is on.
+	bool bFlashlightOn = false;
+	FVector LightOrigin = FVector::ZeroVector;
+	FVector LightForward = FVector::ForwardVector;
+	float LightCosHalfAngle = 1.f;
+
+	bool IsInLightCone(const FVector& Pos) const
+	{
+		return bFlashlightOn
+			&& FVector::DotProduct(LightForward, (Pos - LightOrigin).GetSafeNormal()) >= LightCosHalfAngle;
+	}
+};
+
+/** Tunables copied off the actor at registration — read every update, never written. */
+struct FEnemyAIParams
+{
+	float AttackRange = 90.f;
+	float PatrolRange = 400.f;
+	float LoseAggroMultiplier = 1.5f;
+	float IdleWaitTime = 2.f;
+	float AlertInvestigateTime = 4.f;
+	float PatrolSpeed = 150.f;
+	float AlertSpeed = 200.f;
+	float ChaseSpeed = 300.f;
+};
+
+/** Wall time (ms) of each phase of the last UEnemyAIManager update. Read by TwoDSurvival.Enemy.ScaleBenchmark. */
+struct FEnemyAIPhaseTimings
+{
+	double GatherMs = 0.0;			// Includes the player-nearby spatial query.
+	double NoiseMs = 0.0;
+	double SignificanceMs = 0.0;	// 0 on frames between re-scores.
+	double CrowdMs = 0.0;
+	double DecideMs = 0.0;
+	double WriteBackMs = 0.0;		// Includes deferred removals.
+
+	double TotalMs() const { return GatherMs + NoiseMs + SignificanceMs + CrowdMs + DecideMs + WriteBackMs; }
+};
+
+/**
+ * Runs the Idle → Patrol → Alert → Chase → Attack state machine for every AEnemyBase in the
+ * world in one batched pass, so enemies have no per-actor Tick.
+ *
+ * AI state lives here in parallel arrays indexed by slot (AEnemyBase::AISlot), not on the
+ * actors. Each frame:
+ *   Gather     — actor position, target position and combat flags into the arrays, and the
+ *                player, flashlight cone and sight blockers into an FEnemyAIFrameSnapshot; only
+ *                enemies the spatial index finds near the player test for it. A player in range
+ *                is seen only if no wall, slab or closed door lies between (UOcclusionSpanCache).
+ *                Chasers and investigators whose goal is in another room of a building get the
+ *                next room on its room-graph path (GatherDetours).
+ *   Noise      — the frame's queued noises (ReportNoise) reach enemies in range.
+ *   Crowd      — enemies sorted by (height lane, X); one walk over the order gives each the gap
+ *                to its neighbours and its attack rank. See UpdateCrowd.
+ *   Decide     — state transitions, timers and steering. Reads only the snapshot and the slot's
+ *                own entries and writes only the slot's own entries, with side effects queued as
+ *                EEnemyAIAction commands — so it runs as a ParallelFor once there are
+ *                ParallelDecideMinEnemies, and decides the same whatever the thread count.
+ *   Write-back — on the game thread: targets, state side effects (SetEnemyState), movement
+ *                input, facing and attacks, slot by slot.
+ *
+ * AEnemyBase::CurrentState and CachedPlayer are mirrors written back here, kept for the
+ * AnimBP, loot and street capture. Events raised on the actor (noise, damage, restore)
+ * come through HearNoise / AggroOn / ForceState. Dead enemies are unregistered.
+ *
+ * Significance: every SignificanceInterval each enemy is scored into an EEnemySignificance
+ * bucket, whose FEnemySignificanceTick sets how often it decides, how often its movement
+ * component and mesh tick, and how its animation is updated — visibility-based tick option
+ * and update rate optimization (URO) eval rate, interpolated or not. Movement input is held
+ * between decides so slow buckets keep walking. Demotion by distance needs
+ * SignificanceHysteresis of extra distance, so enemies pacing on a threshold don't flicker.
+ * Populations: `stat EnemyAI`.
+ *
+ * Scaling: the TwoDSurvival.Enemy.ScaleBenchmark automation test times this update per phase
+ * (GetLastPhaseTimings) alongside movement and overlaps at several enemy counts, headless, and
+ * writes JSON under Saved/Benchmarks.
+ *
+ * Crowd: an enemy doesn't step toward a neighbour closer than SeparationRadius — patrols turn
+ * around, investigations stop short, chasers queue behind the one in front — so capsules don't
+ * pile up and fight through movement depenetration. Only the AttackSlotsPerSide engaged enemies
+ * nearest their target on each side may attack it; the rest hold inside their attack range,
+ * facing the target, until a slot frees up.
+ *
+ * Scent: the player's path on the ground is laid into an FScentField every frame, on the lane
+ * of their feet (of the floor, inside a building) — a jump leaves no trail in the air and is
+ * bridged on landing. A chase that loses its target becomes an investigation of the last place
+ * the target was seen, and an enemy done walking to an investigation point climbs the scent
+ * gradient while it is at least ScentFollowStrength — so enemies track the player past their
+ * detection range without it having to be larger.
+ *
+ * Noise: reports within NoiseCoalesceDistance of one already queued this frame merge into it
+ * (loudest wins). Inside ABuildingGenerator buildings the radius is scaled by the room graph's
+ * transmission between the noise's room and the enemy's — closed doors and floor slabs muffle.
+ *
+ * Rooms: a chase or investigation whose goal is in another room of the same building, beyond
+ * the one next door on the same floor, follows FBuildingRoomGraph's cached A* path one room at
+ * a time — along the floor to the next room, or up or down the stairs (teleported, as
+ * AVerticalTransport moves the player) when the next room is on another floor. With the goal
+ * behind a closed door there is no path, and the enemy heads straight along X as before.
+ * Outdoors counts as the graph's outside node, so enemies go in and out through the entrances.
+ *
+ * Tune in DefaultGame.ini under [/Script/TwoDSurvival.EnemyAIManager].
+ */
+UCLASS(Config = Game)
+class TWODSURVIVAL_API UEnemyAIManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Called by AEnemyBase::BeginPlay. */
+	void RegisterEnemy(AEnemyBase* Enemy);
+
+	/** Called by AEnemyBase on death and EndPlay. Safe to call for unregistered enemies. */
+	void UnregisterEnemy(AEnemyBase* Enemy);
+
+	/** Queues a noise heard up to Radius away. Propagated to enemies at the next update. */
+	void ReportNoise(const FVector& Origin, float Radius);
+
+	/** Noise heard — investigate Origin unless already chasing or attacking. */
+	void HearNoise(AEnemyBase* Enemy, const FVector& Origin);
+
+	/** Hit by Attacker — target them and chase unless mid-attack. */
+	void AggroOn(AEnemyBase* Enemy, ABaseCharacter* Attacker);
+
+	/** Puts an enemy straight into NewState (timers reset), e.g. after a street restore. */
+	void ForceState(AEnemyBase* Enemy, EEnemyState NewState);
+
+	/** X the enemy patrols around and X it last investigated. False if it isn't registered. */
+	bool GetPatrolAnchors(const AEnemyBase* Enemy, float& OutSpawnX, float& OutAlertX) const;
+
+	/** Overrides the anchors registration took from the actor, e.g. a promoted horde member's. */
+	void SetPatrolAnchors(AEnemyBase* Enemy, float InSpawnX, float InAlertX);
+
+	int32 Num() const { return Enemies.Num(); }
+
+	const FEnemyAIPhaseTimings& GetLastPhaseTimings() const { return LastPhaseTimings; }
+
+	const FScentField& GetScentField() const { return Scent; }
+
+	// ── Significance config ──────────────────────────────────────────────────
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+	float CriticalDistance = 1200.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+	float NearDistance = 3000.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+	float FarDistance = 8000.f;
+
+	// Extra distance past a threshold before an enemy is demoted to the next bucket.
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+	float SignificanceHysteresis = 300.f;
+
+	// Seconds between re-scoring every enemy.
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+	float SignificanceInterval = 0.25f;
+
+	// How long after its last render an enemy still counts as on screen.
+	UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+	float OnScreenTolerance = 0.3f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTick CriticalTick;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTick NearTick;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTick FarTick;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Significance")
+	FEnemySignificanceTick DormantTick;
+
+	// ── Noise config ─────────────────────────────────────────────────────────
+
+	// Noises reported this close to one already queued this frame are merged into it.
+	UPROPERTY(Config, EditAnywhere, Category = "Noise", meta = (ClampMin = "0.0"))
+	float NoiseCoalesceDistance = 100.f;
+
+	// Fraction of a noise's radius that carries through a closed door.
+	UPROPERTY(Config, EditAnywhere, Category = "Noise", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float ClosedDoorNoiseFactor = 0.15f;
+
+	// Fraction of a noise's radius that carries through a floor with no stairs.
+	UPROPERTY(Config, EditAnywhere, Category = "Noise", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float FloorSlabNoiseFactor = 0.25f;
+
+	// ── Crowd config ─────────────────────────────────────────────────────────
+
+	// Closest (cm, along X) an enemy walks up to a neighbour on its lane.
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "0.0"))
+	float SeparationRadius = 70.f;
+
+	// Enemies allowed to attack one target from each side at once.
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "1"))
+	int32 AttackSlotsPerSide = 2;
+
+	// Height (cm) of one lane. Only enemies on the same lane — street or building floor — space out.
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "1.0"))
+	float CrowdLaneHeight = 200.f;
+
+	// ── Scent config ─────────────────────────────────────────────────────────
+
+	// Width (cm) of one scent bin. Lanes are CrowdLaneHeight tall.
+	UPROPERTY(Config, EditAnywhere, Category = "Scent", meta = (ClampMin = "1.0"))
+	float ScentBinWidth = 50.f;
+
+	// Width (cm) of the bin blocks allocated where the player walks — about one street.
+	UPROPERTY(Config, EditAnywhere, Category = "Scent", meta = (ClampMin = "100.0"))
+	float ScentChunkWidth = 4000.f;
+
+	// Seconds for a trail to fade to half strength.
+	UPROPERTY(Config, EditAnywhere, Category = "Scent", meta = (ClampMin = "0.1"))
+	float ScentHalfLife = 15.f;
+
+	// Weakest scent an investigating enemy still follows. Fainter trails are freed.
+	UPROPERTY(Config, EditAnywhere, Category = "Scent", meta = (ClampMin = "0.01", ClampMax = "1.0"))
+	float ScentFollowStrength = 0.25f;
+
+	// Player moves this much further than their max speed covers since the last deposit
+	// (teleports, doors) leave no trail between.
+	UPROPERTY(Config, EditAnywhere, Category = "Scent", meta = (ClampMin = "0.0"))
+	float ScentMaxStep = 500.f;
+
+	// ── Threading config ─────────────────────────────────────────────────────
+
+	// Registered enemies needed before the decide pass runs in parallel. Below this the task
+	// overhead costs more than it saves.
+	UPROPERTY(Config, EditAnywhere, Category = "Threading", meta = (ClampMin = "0"))
+	int32 ParallelDecideMinEnemies = 256;
+
+	// Slots per ParallelFor batch.
+	UPROPERTY(Config, EditAnywhere, Category = "Threading", meta = (ClampMin = "1"))
+	int32 DecideBatchSize = 64;
+
+	const FEnemySignificanceTick& GetTickSettings(EEnemySignificance Bucket) const;
+
+	/** Enemies currently in Bucket. */
+	int32 GetBucketPopulation(EEnemySignificance Bucket) const { return BucketPopulation[(int32)Bucket]; }
+
+private:
+	// ── Per-enemy state (one entry per slot) ─────────────────────────────────
+
+	UPROPERTY()
+	TArray<TObjectPtr<AEnemyBase>> Enemies;
+
+	TArray<FVector> Positions;
+	TArray<EEnemyState> States;
+
+	// Seconds spent idling (Idle) or waiting at the noise location (Alert).
+	TArray<float> StateTimers;
+
+	TArray<TWeakObjectPtr<ABaseCharacter>> Targets;
+
+	// Targets' positions, gathered each frame for the slots flagged HasTarget.
+	TArray<FVector> TargetLocations;
+
+	// AggroRange — doubled per frame for enemies inside the player's flashlight cone.
+	TArray<float> DetectionRanges;
+
+	// Largest DetectionRanges entry ever registered — bounds the target acquisition query.
+	float MaxDetectionRange = 0.f;
+
+	TArray<float> SpawnX;
+	TArray<float> AlertX;
+
+	// Height of the noise being investigated — with AlertX, the room it came from.
+	TArray<float> AlertZ;
+
+	// Floor-level middle of the next room on the room-graph path to the goal, for slots flagged
+	// Detour this frame.
+	TArray<FVector> DetourLocations;
+
+	// +1 = patrolling right, -1 = patrolling left.
+	TArray<float> PatrolDirs;
+
+	// +1 = facing right, -1 = facing left. SetActorRotation is only called on a flip.
+	TArray<int8> Facings;
+
+	TArray<EEnemyAIFlags> Flags;
+	TArray<FEnemyAIParams> Params;
+
+	TArray<EEnemySignificance> Buckets;
+
+	// Seconds since the slot last ran DecideSlot — passed as its DeltaTime.
+	TArray<float> SinceDecide;
+
+	// Decide output. Move is held until the next decide; other actions fire once.
+	TArray<EEnemyAIAction> Actions;
+	TArray<float> MoveDirs;
+	TArray<float> MoveSpeeds;
+
+	// Capsule half height — Positions are capsule centres, scent lookups need the feet.
+	TArray<float> FootOffsets;
+
+	// ── Crowd state ──────────────────────────────────────────────────────────
+
+	// Slots sorted by (lane, X). Kept between frames so re-sorting is an insertion sort over a
+	// nearly sorted array.
+	TArray<int32> CrowdOrder;
+	TArray<int32> CrowdLanes;
+
+	// Distance along X to the nearest neighbour on the same lane, each side (MAX_flt if none).
+	TArray<float> GapsLeft;
+	TArray<float> GapsRight;
+
+	// Engaged enemies between this one and its target on the same side and lane.
+	TArray<int32> AttackRanks;
+
+	// ── Significance state ───────────────────────────────────────────────────
+
+	float SignificanceTimer = 0.f;
+	int32 BucketPopulation[(int32)EEnemySignificance::Num] = {};
+
+	// ── Noise queue ──────────────────────────────────────────────────────────
+
+	struct FNoiseEvent
+	{
+		FVector Origin;
+		float Radius;
+	};
+	TArray<FNoiseEvent> NoiseQueue;
+
+	// ── Scent ────────────────────────────────────────────────────────────────
+
+	FScentField Scent;
+
+	// Where and when the player last stood on the ground — a jump's take-off until they land.
+	FVector LastScentLocation = FVector::ZeroVector;
+	float LastScentTime = -1.f;
+
+	FDelegateHandle WorldOffsetHandle;
+
+	FEnemyAIPhaseTimings LastPhaseTimings;
+
+	// Set during Tick — removals are deferred so slot indices stay stable mid-pass.
+	bool bUpdating = false;
+	TArray<int32> PendingRemovals;
+
+	void SetState(int32 Slot, EEnemyState NewState);
+	void NotifyNoise(int32 Slot, const FVector& Origin);
+
+	// Drains NoiseQueue into NotifyNoise for every enemy within attenuated range.
+	void PropagateNoise();
+
+	// Flags Detour (and Climb) on pursuing and investigating slots whose goal is in another room
+	// of a building, and snapshots FBuildingRoomGraph::GetNextHop's room into DetourLocations.
+	void GatherDetours();
+
+	// Safe off the game thread — see the class comment.
+	void DecideSlot(int32 Slot, float DeltaTime, const FEnemyAIFrameSnapshot& Frame);
+	void RemoveSlot(int32 Slot);
+
+	// Re-buckets every enemy and applies component tick intervals on bucket changes.
+	void UpdateSignificance(const ABaseCharacter* Player, const FVector& PlayerLocation);
+
+	void ApplyBucketTicks(AEnemyBase* Enemy, EEnemySignificance Bucket) const;
+
+	// Lays the player's step since last frame into Scent and frees trails too faint to follow.
+	// Only steps on the ground are laid; landing fills the trail back to the take-off.
+	void UpdateScent(const ABaseCharacter* Player, const FVector& PlayerLocation, float Now);
+
+	// Scent bins are keyed on world X — a rebase clears them.
+	void OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin);
+
+	// Re-sorts CrowdOrder and fills GapsLeft / GapsRight / AttackRanks. O(n) per frame.
+	void UpdateCrowd();
+
+	// True if stepping along DirX would close on a neighbour nearer than SeparationRadius.
+	bool IsCrowdBlocked(int32 Slot, float DirX) const;
+
+	// Building + floor the position is in, or (INDEX_NONE, INDEX_NONE) outdoors.
+	static FIntPoint GetFloorContext(const TArray<const ABuildingGenerator*>& Buildings, const FVector& WorldPos);
+};
@@ -14,11 +14,18 @@ class UWidgetComponent;
 class UAnimMontage;
 class ABaseCharacter;
 class UEnemyHealthBarWidget;
+class UEnemyAIManager;
+class UEnemyPool;
+class UStaticMesh;
+class UEnemyMoverComponent;
 
 /**
  * Base class for all zombie-like melee enemies.
- * Uses a C++ state machine (Idle → Patrol → Chase → Attack → Dead).
+ * Uses a C++ state machine (Idle → Patrol → Chase → Attack → Dead), run for all enemies at once
+ * by UEnemyAIManager — the actor itself does not tick.
  * Implements IDamageable so player weapons can hit it.
+ * Spawned and retired through UEnemyPool, so one actor can live several lives — anything set
+ * during a life must be put back in ResetForReuse.
  * Subclass in Blueprint (BP_EnemyBase) to assign mesh, AnimBP, loot table, and montages.
  */
 UCLASS()
@@ -26,6 +33,10 @@ class TWODSURVIVAL_API AEnemyBase : public ACharacter, public IDamageable
 {
 	GENERATED_BODY()
 
+	friend class UEnemyAIManager;
+	friend class UEnemyPool;
+	friend class FEnemyCombatStampsTest;
+
 public:
 	AEnemyBase();
 
@@ -43,6 +54,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
 	TObjectPtr<UWidgetComponent> HealthBarComp;
 
+	// Optional 2D kinematic mover — replaces character movement on streets when bUseKinematicMover is set.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
+	TObjectPtr<UEnemyMoverComponent> Mover;
+
 	// --- AI Config (EditDefaultsOnly — tune in BP_EnemyBase) ---
 
 	// Radius within which the enemy detects and chases the player.
@@ -73,7 +88,7 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
 	float IdleWaitTime = 2.f;
 
-	// Seconds before the actor is destroyed after death.
+	// Seconds before the actor is returned to UEnemyPool after death.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
 	float DeathDestroyDelay = 3.f;
 
@@ -126,23 +141,36 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "UI")
 	TSubclassOf<UUserWidget> HealthBarWidgetClass;
 
+	// Drawn instanced for this enemy while it is a UHordeManager member, pivot at the capsule
+	// centre. Without one, horde members of this class are simulated but invisible until promoted.
+	UPROPERTY(EditDefaultsOnly, Category = "Horde")
+	TObjectPtr<UStaticMesh> HordeProxyMesh;
+
 	// --- IDamageable ---
 
 	virtual void TakeMeleeDamage_Implementation(float Amount, AActor* DamageSource) override;
 
-	// Called by UNoiseEmitterComponent when a noise is heard within range.
-	// Transitions to the Alert state unless already chasing or attacking.
+	// Alerts this enemy to a noise directly, skipping the range and door checks that noises
+	// reported through UNoiseEmitterComponent get. Transitions to the Alert state unless
+	// already chasing or attacking.
 	void HearNoise(FVector NoiseOrigin);
 
+	// Called by UStreetManager when re-materializing an enemy captured on an unloaded street.
+	// Alert/Chase/Attack have no target after the round trip, so they resume as Idle.
+	void RestoreSavedState(float BodyHealth, EEnemyState SavedState);
+
 	// Called by AnimNotify_BeginAttack — enables the melee hitbox at the correct animation frame.
 	void EnableMeleeHitbox();
 
 	// Called by AnimNotify_EndAttack — disables the melee hitbox early for frame-accurate close.
 	void DisableMeleeHitbox();
 
+	// True while parked in UEnemyPool — hidden, inert and not registered anywhere.
+	bool IsInPool() const { return bInPool; }
+
 	// --- AnimBP-readable state ---
 
-	// Current AI state — read in ABP_Enemy to drive locomotion.
+	// Current AI state — read in ABP_Enemy to drive locomotion. Written by UEnemyAIManager.
 	UPROPERTY(BlueprintReadOnly, Category = "AI")
 	EEnemyState CurrentState = EEnemyState::Idle;
 
@@ -156,86 +184,60 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-
-public:
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-	// World position at BeginPlay — patrol wanders around this point.
-	FVector SpawnLocation;
+	// Index of this enemy's entry in UEnemyAIManager's arrays. INDEX_NONE when not registered.
+	int32 AISlot = INDEX_NONE;
 
-	// World position the enemy is currently investigating after hearing a noise.
-	FVector AlertLocation = FVector::ZeroVector;
+	// Facing last applied by UEnemyAIManager: +1 = right, -1 = left.
+	int8 FacingSign = 1;
 
-	// Accumulated seconds spent waiting at AlertLocation.
-	float AlertTimer = 0.f;
+	bool bInPool = false;
 
-	// True once the enemy has reached AlertLocation and is now waiting.
-	bool bReachedAlertLocation = false;
+	// Capsule collision from BeginPlay — death turns it off, reuse turns it back on.
+	TEnumAsByte<ECollisionEnabled::Type> DefaultCapsuleCollision = ECollisionEnabled::QueryAndPhysics;
 
-	// +1 = patrolling right, -1 = patrolling left.
-	float PatrolDir = 1.f;
-
-	// Accumulated time spent in Idle state.
-	float IdleTimer = 0.f;
-
-	// Weak ref to the player — set on aggro, cleared on lose-aggro.
+	// Weak ref to the player — set on aggro, cleared on lose-aggro. Written by UEnemyAIManager.
 	TWeakObjectPtr<ABaseCharacter> CachedPlayer;
 
-	// False during attack cooldown.
-	bool bCanAttack = true;
-
 	// Actors already hit this swing — prevents multi-hit per swing.
 	TSet<AActor*> HitActorsThisSwing;
 
-	// True from swing start until AttackCooldown + PostAttackStandStillDuration elapses.
-	// Blocks state transitions and new attacks during that window.
-	bool bPostAttackMoveLocked = false;
+	// --- Combat stamps ---
+	// World time (UWorld::GetTimeSeconds) at which each swing-cycle event is due. Checked by
+	// UEnemyAIManager every frame instead of four timers being set and cleared per swing.
 
-	// True from swing start until AttackRotationLockDuration elapses.
-	// Freezes facing direction so the player can jump over mid-swing.
-	bool bRotationLocked = false;
+	// Safety close of the melee hitbox if AnimNotify_EndAttack is missed. 0 = hitbox closed.
+	double SwingEndTime = 0.0;
 
-	FTimerHandle SwingTimerHandle;
-	FTimerHandle AttackCooldownTimer;
-	FTimerHandle PostAttackMoveTimer;
-	FTimerHandle RotationLockTimer;
-	FTimerHandle DeathDestroyTimer;
+	// End of AttackCooldown: may attack again, bIsAttacking clears.
+	double AttackReadyTime = 0.0;
+
+	// End of AttackCooldown + PostAttackStandStillDuration. Until then state transitions and
+	// new attacks are blocked.
+	double MoveUnlockTime = 0.0;
+
+	// End of AttackRotationLockDuration. Until then facing is frozen so the player can jump
+	// over mid-swing.
+	double RotationUnlockTime = 0.0;
 
-	// Returns the player if within AggroRange, nullptr otherwise.
-	ABaseCharacter* DetectPlayer() const;
+	bool CanAttackAt(double Now) const { return Now >= AttackReadyTime; }
+	bool IsMoveLockedAt(double Now) const { return Now < MoveUnlockTime; }
+	bool IsRotationLockedAt(double Now) const { return Now < RotationUnlockTime; }
 
-	// Per-state tick methods — each handles its own transitions.
-	void TickIdle(float DeltaTime);
-	void TickPatrol(float DeltaTime);
-	void TickAlert(float DeltaTime);
-	void TickChase(float DeltaTime);
-	void TickAttack(float DeltaTime);
+	// Death happens once per life — the only combat event left on the timer manager.
+	FTimerHandle DeathDestroyTimer;
 
 	// Changes state and applies associated movement speed / side-effects.
 	void SetEnemyState(EEnemyState NewState);
 
-	// Adds movement input in DirX direction and rotates character to face it.
-	void MoveInDirection(float DirX, float Speed);
-
-	// Enables hitbox, plays montage, starts swing and cooldown timers.
+	// Plays the montage and stamps the cooldown, stand-still and rotation lock ends.
 	void BeginMeleeAttack();
 
-	// Disables hitbox and clears swing timer. Called by timer or manually.
-	UFUNCTION()
-	void EndMeleeAttack();
-
-	// Resets bCanAttack and bIsAttacking after AttackCooldown.
-	UFUNCTION()
-	void ResetAttackCooldown();
-
-	// Clears bPostAttackMoveLocked after AttackCooldown + PostAttackStandStillDuration.
-	UFUNCTION()
-	void OnPostAttackMoveUnlocked();
-
-	// Clears bRotationLocked after AttackRotationLockDuration.
-	UFUNCTION()
-	void OnRotationLockExpired();
+	// Applies the combat stamps due by Now: closes an overrunning swing, ends the attack.
+	// Called by UEnemyAIManager's gather every frame.
+	void ExpireCombatStamps(double Now);
 
 	// Overlap handler for MeleeHitbox.
 	UFUNCTION()
@@ -254,10 +256,22 @@ private:
 	// Rolls loot table and spawns AWorldItem actors at death location.
 	void SpawnLoot();
 
-	// Called by DeathDestroyTimer — removes the actor from the world.
+	// Called by DeathDestroyTimer — hands the actor back to UEnemyPool.
 	UFUNCTION()
 	void DestroyEnemy();
 
+	// --- Pooling (called by UEnemyPool) ---
+
+	// Puts every per-life field back to its spawn value: health, combat stamps and timers,
+	// HitActorsThisSwing, state, montages and the health bar.
+	void ResetForReuse();
+
+	// Unregisters from UEnemyAIManager, resets, and hides the actor with collision and movement off.
+	void EnterPool();
+
+	// Moves a parked actor to Location, shows it, restores collision and movement and re-registers.
+	void LeavePool(const FVector& Location, const FRotator& Rotation);
+
 	// Caches widget instance and makes the health bar visible.
 	void ShowHealthBar();
 
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "EnemyMoverComponent.generated.h"
+
+class ACharacter;
+class UCharacterMovementComponent;
+class UCapsuleComponent;
+class UGroundSpanCache;
+
+/**
+ * Cheap side-scroller movement for AEnemyBase, used instead of UCharacterMovementComponent
+ * while an enemy walks a street. Off unless bUseKinematicMover is set on the enemy Blueprint.
+ *
+ * Each tick it consumes the pawn's movement input, accelerates along X with the movement
+ * component's MaxWalkSpeed / MaxAcceleration / BrakingDecelerationWalking, follows the ground
+ * from UGroundSpanCache — every bin the step crosses, not just the last — and applies gravity
+ * when there is none. It moves the capsule without sweeping, except when:
+ *   - the ground in a crossed bin rises past MaxStepHeight,
+ *   - the step skips whole bins (long ticks in slow significance buckets), so a wall between
+ *     samples can't be tunnelled through,
+ *   - a pawn is within reach (SetNearestPawnGap, fed by UEnemyAIManager's crowd pass),
+ * and it keeps sweeping until a move completes unblocked. Velocity and movement mode are
+ * written to the character movement component, so GetVelocity, the AnimBP and
+ * StopMovementImmediately work unchanged.
+ *
+ * Hands back to character movement (re-enabling its tick) inside ABuildingGenerator floors —
+ * doors, stairs and slabs — and while root motion plays, and takes over again once the enemy
+ * is on the ground outside.
+ */
+UCLASS(ClassGroup = (Enemy), meta = (BlueprintSpawnableComponent))
+class TWODSURVIVAL_API UEnemyMoverComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyMoverComponent();
+
+	// Drive this enemy with the mover instead of character movement where possible.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mover")
+	bool bUseKinematicMover = false;
+
+	// Horizontal speed lost per second while airborne from a knockback (cm/s²).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mover", meta = (ClampMin = "0.0"))
+	float AirDeceleration = 200.f;
+
+	// Slack (cm) beyond both capsules' radii within which a pawn makes the step sweep.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mover", meta = (ClampMin = "0.0"))
+	float PawnSweepMargin = 50.f;
+
+	/** True while the mover, not character movement, is moving the enemy. */
+	bool IsDrivingMovement() const { return bUseKinematicMover && !bDeferring; }
+
+	/** Adds Impulse (cm/s) to the velocity. Upward impulses leave the ground. */
+	void AddImpulse(const FVector& Impulse);
+
+	/** X distance between centres to the nearest pawn on this enemy's height lane. */
+	void SetNearestPawnGap(float Gap) { NearestPawnGap = Gap; }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	UPROPERTY()
+	TObjectPtr<ACharacter> Character;
+
+	UPROPERTY()
+	TObjectPtr<UCharacterMovementComponent> CharacterMovement;
+
+	UPROPERTY()
+	TObjectPtr<UCapsuleComponent> Capsule;
+
+	UPROPERTY()
+	TObjectPtr<UGroundSpanCache> Ground;
+
+	bool bGrounded = true;
+
+	// Last sweep hit something — keep sweeping until a move goes through.
+	bool bInContact = false;
+
+	// Character movement is driving (special case) — the mover only watches for a chance to take over.
+	bool bDeferring = false;
+
+	float NearestPawnGap = MAX_flt;
+
+	// Inside a building or playing root motion.
+	bool NeedsCharacterMovement(const FVector& Location) const;
+
+	void HandOver();
+	void TakeOver();
+
+	void Step(float DeltaTime);
+	void SetGrounded(bool bInGrounded);
+};
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EnemyPool.generated.h"
+
+class AEnemyBase;
+
+/** Lifetime counters for one enemy class. */
+struct FEnemyPoolStats
+{
+	int32 Spawned = 0;		// Acquires that had to construct a new actor (warm-up excluded).
+	int32 Reused = 0;		// Acquires served from the pool.
+	int32 WarmedUp = 0;		// Actors constructed ahead of time by WarmUp.
+	int32 Released = 0;		// Enemies parked for reuse.
+	int32 Destroyed = 0;	// Enemies destroyed instead — pool full or not poolable.
+};
+
+/**
+ * Parked enemies of one class, ready to reuse.
+ * Weak — a parked actor destroyed by anything else just drops out.
+ */
+struct FEnemyClassPool
+{
+	TArray<TWeakObjectPtr<AEnemyBase>> Free;
+
+	// Actors still to construct for the last WarmUp request.
+	int32 PendingWarmUp = 0;
+
+	FEnemyPoolStats Stats;
+};
+
+/**
+ * Per-class pool of AEnemyBase actors, so spawning an enemy doesn't pay for actor construction,
+ * component registration, the health bar widget and the eventual GC every time.
+ *
+ * Acquire replaces SpawnActor for enemies (street restore, spawn points, raids); Release replaces
+ * Destroy (death, street capture). A released enemy is reset (AEnemyBase::ResetForReuse — health,
+ * combat timers and flags, HitActorsThisSwing, state, montages, health bar), unregistered from
+ * UEnemyAIManager and UActorSpatialIndex, hidden with collision and movement off, and parked
+ * where it stands. Acquire moves it to the spawn point and reverses all of that.
+ *
+ * Only enemies in the persistent level are pooled — level-placed ones are destroyed with their
+ * streamed level anyway. At most MaxPooledPerClass are parked per class; the rest are destroyed.
+ *
+ * Warm-up: when a street loads, every AEnemyBase class in its AWorldEventSpawnPoint pools is
+ * topped up to WarmUpPerClass parked actors, MaxWarmUpSpawnsPerFrame at a time. AWorldEventManager
+ * warms its raid classes the same way. Counters: TwoD.EnemyPoolStats.
+ *
+ * Tune in DefaultGame.ini under [/Script/TwoDSurvival.EnemyPool].
+ */
+UCLASS(Config = Game)
+class TWODSURVIVAL_API UEnemyPool : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Most enemies parked per class. Releases past this destroy the enemy.
+	UPROPERTY(Config, EditAnywhere, Category = "Enemy Pool", meta = (ClampMin = "0"))
+	int32 MaxPooledPerClass = 16;
+
+	// Parked actors each enemy class on a newly loaded street is topped up to.
+	UPROPERTY(Config, EditAnywhere, Category = "Enemy Pool", meta = (ClampMin = "0"))
+	int32 WarmUpPerClass = 4;
+
+	// Warm-up actors constructed per frame, across all classes.
+	UPROPERTY(Config, EditAnywhere, Category = "Enemy Pool", meta = (ClampMin = "1"))
+	int32 MaxWarmUpSpawnsPerFrame = 2;
+
+	// Where warm-up actors are constructed before being parked. Out of sight, below the streets.
+	UPROPERTY(Config, EditAnywhere, Category = "Enemy Pool")
+	FVector WarmUpLocation = FVector(0.f, 0.f, -50000.f);
+
+	/**
+	 * Returns a reset enemy of Class at Location — parked if one is free, otherwise spawned.
+	 * The location is adjusted out of blocking geometry like
+	 * ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn.
+	 */
+	AEnemyBase* Acquire(TSubclassOf<AEnemyBase> Class, const FVector& Location, const FRotator& Rotation);
+
+	/** Parks Enemy for reuse, or destroys it if it can't be pooled. Safe to call twice. */
+	void Release(AEnemyBase* Enemy);
+
+	/** Constructs enough actors over the next frames for Class to have Count parked. */
+	void WarmUp(TSubclassOf<AEnemyBase> Class, int32 Count);
+
+	/** Number of parked enemies of Class. */
+	int32 NumFree(TSubclassOf<AEnemyBase> Class) const;
+
+	/** Per-class parked count, counters and reuse rate. */
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	TMap<TObjectKey<UClass>, FEnemyClassPool> Pools;
+
+	FDelegateHandle StreetChangedHandle;
+
+	// Tops up the spawn point enemy classes of the street that just became current.
+	void OnStreetChanged();
+
+	// Hides, resets and unindexes Enemy, then adds it to its class's free list.
+	void Park(AEnemyBase* Enemy, FEnemyClassPool& Pool);
+};
@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Enemy/EnemyTypes.h"
+#include "HordeManager.generated.h"
+
+class AEnemyBase;
+class UInstancedStaticMeshComponent;
+
+/**
+ * One horde zombie that is not an actor. Only walks along X at a fixed Y/Z.
+ * Positions are world space while the member is in UHordeManager.
+ */
+struct FHordeMember
+{
+	FVector Position = FVector::ZeroVector;
+
+	// Patrol wanders PatrolRange either side of HomeX.
+	float HomeX = 0.f;
+
+	// Walked to and investigated while Alert.
+	float AlertX = 0.f;
+
+	float BodyHealth = 0.f;
+	float StateTimer = 0.f;
+
+	// Idle, Patrol or Alert — engaged enemies are never demoted.
+	EEnemyState State = EEnemyState::Idle;
+
+	// Walking / facing direction: +1 = right, -1 = left.
+	int8 Dir = 1;
+
+	// Index into UHordeManager's class table (GetMemberClass).
+	uint16 ClassIndex = 0;
+};
+
+/** Tunables copied off an enemy class's defaults when the class is first used. */
+struct FHordeClassParams
+{
+	float PatrolRange = 400.f;
+	float IdleWaitTime = 2.f;
+	float AlertInvestigateTime = 4.f;
+	float PatrolSpeed = 150.f;
+	float AlertSpeed = 200.f;
+};
+
+/**
+ * Hordes of enemies kept as plain FHordeMember structs instead of AEnemyBase actors, so a
+ * highway street can hold thousands. Members run a cut-down Idle/Patrol/Alert loop along X and are
+ * drawn through one UInstancedStaticMeshComponent per class (AEnemyBase::HordeProxyMesh),
+ * only within DrawDistance of the player.
+ *
+ * Members within PromoteDistance of the player become full enemies via UEnemyPool, at most
+ * MaxPromotionsPerFrame per frame and MaxPromoted at once. Health, state, home and alert X carry
+ * over. Promoted enemies that are idle, patrolling or alert and past DemoteDistance become
+ * members again. Chasing and attacking enemies stay actors until they disengage or die.
+ *
+ * Members are staged by AHordeSpawnPoint. FStreetStateStore takes a street's members, and
+ * demotes its promoted enemies, when the street is captured, and hands them back on restore.
+ *
+ * Counters: TwoD.HordeStats. Tune in DefaultGame.ini under [/Script/TwoDSurvival.HordeManager].
+ */
+UCLASS(Config = Game)
+class TWODSURVIVAL_API UHordeManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// X distance (cm) from the player inside which members become full enemies.
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0.0"))
+	float PromoteDistance = 2500.f;
+
+	// X distance past which idle, patrolling and alert promoted enemies become members again.
+	// Keep it above PromoteDistance so enemies on the boundary don't flicker.
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0.0"))
+	float DemoteDistance = 3500.f;
+
+	// Promotions per frame — each one is a pool acquire, or a spawn when the pool is dry.
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "1"))
+	int32 MaxPromotionsPerFrame = 4;
+
+	// Promoted enemies alive at once. Members past the cap stay instanced even when close.
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0"))
+	int32 MaxPromoted = 64;
+
+	// X distance from the player inside which members are drawn.
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0.0"))
+	float DrawDistance = 8000.f;
+
+	// Seconds between member simulation steps. 0 = every frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0.0"))
+	float SimInterval = 0.f;
+
+	/** Adds Count members of Class spread evenly at random over Spread cm of X around Center. */
+	void StageHorde(TSubclassOf<AEnemyBase> Class, const FVector& Center, float Spread, int32 Count);
+
+	/**
+	 * Demotes every promoted enemy with X in [MinX, MaxX), then moves all members in that span
+	 * into Out. Used by FStreetStateStore::Capture.
+	 */
+	void ExtractSpan(float MinX, float MaxX, TArray<FHordeMember>& Out);
+
+	/** Adds members built by the caller (ClassIndex from FindOrAddClass). */
+	void AddMembers(TConstArrayView<FHordeMember> InMembers);
+
+	/** Class table index for Class, adding it on first use. */
+	uint16 FindOrAddClass(TSubclassOf<AEnemyBase> Class);
+
+	/** Class behind a member's ClassIndex. */
+	UClass* GetMemberClass(uint16 ClassIndex) const;
+
+	int32 NumMembers() const { return Members.Num(); }
+	int32 NumPromoted() const { return Promoted.Num(); }
+
+	/** Member, promoted and drawn counts per class, plus promotion/demotion totals. */
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	TArray<FHordeMember> Members;
+
+	// Enemies promoted from members — the only actors this manager ever demotes.
+	TArray<TWeakObjectPtr<AEnemyBase>> Promoted;
+
+	// Class table, indexed by FHordeMember::ClassIndex. Classes, ClassParams and ClassInstances are parallel.
+	UPROPERTY()
+	TArray<TSubclassOf<AEnemyBase>> Classes;
+
+	TArray<FHordeClassParams> ClassParams;
+
+	// Null for classes without a HordeProxyMesh — their members are simulated but not drawn.
+	UPROPERTY()
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> ClassInstances;
+
+	// Transient actor owning the instanced mesh components.
+	UPROPERTY()
+	TObjectPtr<AActor> InstanceOwner;
+
+	// Per-class instance transforms, rebuilt every frame.
+	TArray<TArray<FTransform>> InstanceScratch;
+
+	float SimAccumulator = 0.f;
+
+	int32 TotalPromotions = 0;
+	int32 TotalDemotions = 0;
+
+	FDelegateHandle WorldOffsetHandle;
+
+	// Idle → Patrol, patrol leash, walk to AlertX and investigate — AEnemyBase's loop without perception.
+	void Simulate(float DeltaTime);
+
+	void PromoteNear(const FVector& PlayerLocation);
+	void DemoteFar(const FVector& PlayerLocation);
+
+	// Turns a promoted enemy back into a member and releases the actor.
+	void Demote(AEnemyBase* Enemy);
+
+	void UpdateInstances(const FVector& PlayerLocation);
+
+	// World origin rebasing moves actors but not these raw positions.
+	void OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin);
+};
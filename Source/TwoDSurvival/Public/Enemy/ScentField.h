@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One street-wide run of scent bins on one lane. */
+struct FScentChunk
+{
+	// World time the player last passed through each bin, -1 where they never did.
+	TArray<float> Times;
+
+	// Latest entry of Times — chunks whose newest scent has fully faded are freed.
+	float Newest = -1.f;
+};
+
+/**
+ * Player trail as a 1D field along X, one row of fixed-width bins per height lane (street or
+ * building floor), owned by UEnemyAIManager. Positions passed in are where the pawn stands —
+ * foot or floor height, not capsule centre — and lanes are centred on multiples of LaneHeight,
+ * so a foot a few cm off the ground stays on the ground's lane.
+ *
+ * Each bin remembers when the player last crossed it; its strength is 2^(-age / HalfLife), so
+ * the field decays without being touched every frame. Times are interpolated across the bins a
+ * frame's step covers, so strength rises strictly along the path and climbing the gradient
+ * leads to where the player went. Bins are allocated in chunks of ChunkWidth (one street) only
+ * where the player has walked. Lookups are a map find plus an index — O(1) — and read-only, so
+ * the decide pass can call them from worker threads.
+ */
+struct TWODSURVIVAL_API FScentField
+{
+	/** Sets the bin and lane sizes. Changing either clears the field. */
+	void Configure(float InBinWidth, float InChunkWidth, float InLaneHeight);
+
+	/**
+	 * Marks the bins from From to To on To's lane, with times running from FromTime at From to
+	 * ToTime at To.
+	 */
+	void Deposit(const FVector& From, float FromTime, const FVector& To, float ToTime);
+
+	/** Frees chunks the player hasn't touched since OlderThan. */
+	void Prune(float OlderThan);
+
+	/** Scent in Pos's bin at Now: 1 just laid, halving every HalfLife seconds, 0 if never. */
+	float Sample(const FVector& Pos, float Now, float HalfLife) const;
+
+	/**
+	 * Direction (+1 / -1) toward the fresher neighbouring bin of Pos, or 0 if Pos's own bin is
+	 * the freshest of the three. OutStrength is the freshest of the three, as in Sample.
+	 */
+	int32 GetUphillDir(const FVector& Pos, float Now, float HalfLife, float& OutStrength) const;
+
+	void Reset();
+
+	int32 NumChunks() const { return Chunks.Num(); }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// Keyed by (chunk, lane).
+	TMap<FIntPoint, FScentChunk> Chunks;
+
+	float BinWidth = 50.f;
+	float LaneHeight = 200.f;
+	int32 BinsPerChunk = 80;
+
+	int32 GetBin(float X) const { return FMath::FloorToInt(X / BinWidth); }
+	int32 GetLane(float Z) const { return FMath::FloorToInt(Z / LaneHeight + 0.5f); }
+	int32 GetChunk(int32 Bin) const { return FMath::FloorToInt((float)Bin / BinsPerChunk); }
+
+	// -1 if the bin was never crossed.
+	float GetBinTime(int32 Bin, int32 Lane) const;
+
+	static float GetStrength(float Time, float Now, float HalfLife);
+};
@@ -71,6 +71,14 @@ public:
 	 */
 	void ApplyDamage(float Amount, ABaseCharacter* DamageSource);
 
+	bool IsBroken() const { return bIsBroken; }
+
+	/**
+	 * Puts the prop straight into its broken state — no loot, sound or OnBroken.
+	 * Used by UStreetManager when a street is shown again. Destroys the owner if bDestroyOnDeath.
+	 */
+	void RestoreBroken();
+
 	// UInteractionBehaviorComponent
 	virtual FText GetPrompt() const override;
 	virtual bool IsAvailable() const override;
@@ -12,8 +12,7 @@
 
 /**
  * One edge in the runtime street graph.
- * Stores FromStreetID → ExitID → ToStreetID so the graph can be rebuilt on load
- * without re-running the random generation.
+ * Legacy: only read from saves made before seeded generation (StreetGraphVersion 0).
  */
 USTRUCT()
 struct FSavedStreetConnection
@@ -195,8 +194,16 @@ public:
 	TArray<FPlacedActorSaveData> PlacedActors;
 
 	// --- Street graph ---
-	// Runtime-generated street connections (FromStreetID → ExitID → ToStreetID).
-	// Only populated after the first GenerateCityGraph() call or on save.
+	// The graph is regenerated from this seed on load (UStreetManager::BuildCityGraph).
+	UPROPERTY()
+	int32 StreetGraphSeed = 0;
+
+	// UStreetManager::CityGraphVersion at save time. 0 = legacy save with edges in SavedStreetGraph.
+	UPROPERTY()
+	int32 StreetGraphVersion = 0;
+
+	// Legacy runtime street connections (FromStreetID → ExitID → ToStreetID).
+	// Read only when StreetGraphVersion is 0; no longer written.
 	UPROPERTY()
 	TArray<FSavedStreetConnection> SavedStreetGraph;
 
@@ -13,6 +13,7 @@ class UCityDefinition;
 
 /**
  * World map widget — shows visited streets as nodes connected by lines.
+ * Layout is a BFS over UStreetManager's street graph from the starting street.
  * Streets are grouped into city regions with colored backgrounds.
  * Highway segments between cities are shown with amber lines.
  * Current street is highlighted gold. Buildings shown as bullet labels per node.
@@ -51,8 +52,8 @@ private:
 		FVector2D    BoxMax;       // canvas bottom-right
 	};
 
-	// Node center positions (canvas local space) — used by NativePaint for line endpoints.
-	TMap<FName, FVector2D> NodeCenters;
+	// Node center positions (canvas local space), indexed by street graph node.
+	TArray<FVector2D> NodeCenters;
 
 	// Street-to-street connections (grey).
 	TArray<TPair<FVector2D, FVector2D>> ConnectionLines;
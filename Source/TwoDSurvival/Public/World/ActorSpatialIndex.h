@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/ObjectKey.h"
+#include "ActorSpatialIndex.generated.h"
+
+class ULevel;
+
+/** What an indexed actor is filed under. An AWorldItem is both an Item and an Interactable. */
+enum class EActorIndexCategory : uint8
+{
+	Enemy,          // AEnemyBase
+	Item,           // AWorldItem
+	Interactable,   // anything implementing IInteractable (doors, props, NPCs, pickups, …)
+	Num
+};
+
+/**
+ * Actors of one category whose X falls in one cell, sorted by X.
+ * Xs and Actors are parallel; binary searches touch only Xs.
+ */
+struct FActorIndexCell
+{
+	TArray<float> Xs;
+	TArray<TObjectKey<AActor>> Actors;
+};
+
+/**
+ * 1D spatial index over X — gameplay is constrained to the X/Z plane, so "near" is an X range.
+ *
+ * Enemies, AWorldItems and interactables are kept per category in cells CellWidth wide, each
+ * sorted by X. Range queries binary search each overlapping cell: O(log n + k).
+ *
+ * Cells default to the default StreetWidth, so a cell holds roughly one street. Building
+ * interiors load BuildingWorldX away from any street, so they never share a cell with one.
+ *
+ * Actors are picked up from spawns and level show/hide and dropped on destroy — no
+ * per-class registration. Enemies are re-keyed every frame. Items and interactables barely
+ * move, so they are re-keyed every StaticRefreshInterval. Re-keying is an insertion sort over
+ * nearly sorted arrays, so it is O(n) in practice. Keys can be up to one refresh stale; callers
+ * that need exact bounds pad the query and filter on GetActorLocation(). A world origin rebase
+ * re-keys every category at once, before anything can query the shifted world.
+ *
+ * Tune in DefaultGame.ini under [/Script/TwoDSurvival.ActorSpatialIndex].
+ */
+UCLASS(Config = Game)
+class TWODSURVIVAL_API UActorSpatialIndex : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Width (cm) of one cell along X.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial Index", meta = (ClampMin = "100.0"))
+	float CellWidth = 4000.f;
+
+	// Seconds between re-keying items and interactables. Enemies are re-keyed every frame.
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial Index", meta = (ClampMin = "0.0"))
+	float StaticRefreshInterval = 0.5f;
+
+	/**
+	 * Calls Visit(AActor*) for every live actor of Category whose indexed X is in [MinX, MaxX],
+	 * cell by cell in ascending X. Visit must not spawn or destroy indexed actors —
+	 * collect with QueryRange first if it does.
+	 */
+	template <typename FuncType>
+	void ForEachInRange(EActorIndexCategory Category, float MinX, float MaxX, FuncType&& Visit) const;
+
+	/** Appends every live actor of Category whose indexed X is in [MinX, MaxX] to Out. */
+	void QueryRange(EActorIndexCategory Category, float MinX, float MaxX, TArray<AActor*>& Out) const;
+
+	/** Number of actors indexed under Category. */
+	int32 Num(EActorIndexCategory Category) const;
+
+	/**
+	 * Indexes / unindexes Actor outside the spawn, destroy and level hooks.
+	 * UEnemyPool drops parked enemies and re-adds them on reuse. Both are no-ops when redundant.
+	 */
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+
+private:
+	TMap<int32, FActorIndexCell> Cells[(int32)EActorIndexCategory::Num];
+
+	// Cell each indexed actor is in, per category (INDEX_NONE = not in that category).
+	struct FEntry
+	{
+		int32 Cell[(int32)EActorIndexCategory::Num];
+	};
+	TMap<TObjectKey<AActor>, FEntry> Entries;
+
+	float StaticRefreshTimer = 0.f;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldOffsetHandle;
+
+	int32 GetCellIndex(float X) const { return FMath::FloorToInt(X / CellWidth); }
+
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+	void OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin);
+
+	// Re-reads X for every actor of Category, moves actors that left their cell and re-sorts.
+	void Refresh(EActorIndexCategory Category);
+
+	static void InsertSorted(FActorIndexCell& Cell, float X, AActor* Actor);
+};
+
+template <typename FuncType>
+void UActorSpatialIndex::ForEachInRange(EActorIndexCategory Category, float MinX, float MaxX, FuncType&& Visit) const
+{
+	if (MaxX < MinX) return;
+
+	const TMap<int32, FActorIndexCell>& CategoryCells = Cells[(int32)Category];
+	const int32 LastCell = GetCellIndex(MaxX);
+	for (int32 CellIndex = GetCellIndex(MinX); CellIndex <= LastCell; ++CellIndex)
+	{
+		const FActorIndexCell* Cell = CategoryCells.Find(CellIndex);
+		if (!Cell) continue;
+
+		for (int32 i = Algo::LowerBound(Cell->Xs, MinX); i < Cell->Xs.Num() && Cell->Xs[i] <= MaxX; ++i)
+		{
+			if (AActor* Actor = Cell->Actors[i].ResolveObjectPtr())
+			{
+				Visit(Actor);
+			}
+		}
+	}
+}
@@ -115,6 +115,17 @@ public:
 		meta = (EditCondition = "bHasElevator"))
 	float ElevatorX = 200.f;
 
+	// ── Navigation ────────────────────────────────────────────────────────────
+
+	// Room graph path cost of climbing one floor by stairs, in cm of level walking.
+	// Walking to the next room costs RoomWidth.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation", meta = (ClampMin = "0.0"))
+	float StairsTraversalCost = 1200.f;
+
+	// Room graph path cost of riding the elevator one floor.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation", meta = (ClampMin = "0.0"))
+	float ElevatorTraversalCost = 2000.f;
+
 	// ── Room pool & floor layouts ─────────────────────────────────────────────
 
 	/**
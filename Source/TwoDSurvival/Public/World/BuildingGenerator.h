@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "World/BuildingDefinition.h"
+#include "World/BuildingRoomGraph.h"
 #include "BuildingGenerator.generated.h"
 
 class URoomDefinition;
@@ -21,6 +22,9 @@ class ABuildingFacadePanel;
  * Generate() also spawns:
  *   - One ABuildingFacadePanel per floor (if FacadePanelClass is set), sized to the floor.
  *   - One ABuildingInteriorVolume covering all floors, which drives per-floor facade fading.
+ * It then records the room adjacency (FBuildingRoomGraph): stairs, floor slabs and the
+ * ADoorActors sitting on shared walls, each walkable link with a path cost. UEnemyAIManager
+ * muffles noise through it and routes chasing enemies across floors over it (GetNextHop).
  *
  * Blueprint child (BP_BuildingGenerator):
  *   - Set BuildingDef in Details.
@@ -50,6 +54,23 @@ public:
 	UFUNCTION(CallInEditor, Category = "Building")
 	void Generate();
 
+	// Floor index (0 = ground) containing WorldPos, or INDEX_NONE if WorldPos is outside the
+	// building's floors (street, rooftop, another building).
+	int32 GetFloorAt(const FVector& WorldPos) const;
+
+	// FBuildingRoomGraph node of the room containing WorldPos, or INDEX_NONE if outside the floors.
+	int32 GetRoomAt(const FVector& WorldPos) const;
+
+	const FBuildingRoomGraph& GetRoomGraph() const { return RoomGraph; }
+
+	// Cheapest room-graph route between two positions (FBuildingRoomGraph::FindPath). Positions
+	// outside the floors count as the street — the graph's outside node.
+	bool FindRoomPath(const FVector& From, const FVector& To, TArray<int32>& OutNodes) const;
+
+	// World position of a room node's floor, at the middle of the room. The outside node and
+	// invalid nodes return the building's origin.
+	FVector GetRoomLocation(int32 Node) const;
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -62,5 +83,12 @@ private:
 	UPROPERTY()
 	TObjectPtr<ABuildingInteriorVolume> InteriorVolume;
 
+	FBuildingRoomGraph RoomGraph;
+
+	// Links rooms on each floor (through any door found on the shared wall) and the ground
+	// entrances to the outside node, then builds the graph's path adjacency. Vertical links
+	// are added while floors are generated.
+	void BuildRoomLinks();
+
 	AActor* SpawnRoomAt(TSubclassOf<AActor> ActorClass, FVector WorldPosition);
 };
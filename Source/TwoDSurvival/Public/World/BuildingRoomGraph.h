@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ADoorActor;
+
+/** How two rooms of a generated building are joined. */
+enum class ERoomLinkKind : uint8
+{
+	Open,     // Side by side on a floor with no door between them.
+	Door,     // An ADoorActor sits on the shared wall — passable only while it is open.
+	Stairs,   // Stair or elevator room linking a floor to the one above.
+	Slab,     // Same slot on adjacent floors, no stairs — solid floor between them.
+};
+
+struct FRoomLink
+{
+	int32 A = INDEX_NONE;
+	int32 B = INDEX_NONE;
+	ERoomLinkKind Kind = ERoomLinkKind::Open;
+	TWeakObjectPtr<ADoorActor> Door;
+
+	// Path cost of crossing the link (cm walked, or the definition's stairs / elevator cost).
+	float Cost = 0.f;
+};
+
+/** One FBuildingRoomGraph::FindPath result. Cost < 0 = unreachable. */
+struct FRoomPath
+{
+	TArray<int32> Nodes;
+	float Cost = -1.f;
+};
+
+/**
+ * Room adjacency of one ABuildingGenerator building, built by Generate().
+ *
+ * Node = Floor * RoomsPerFloor + Room, plus one extra node (GetOutsideNode) for the street,
+ * linked to the two ground-floor entrance slots. Links are undirected.
+ *
+ * Noise transmission between every pair of nodes is precomputed as the best product of
+ * per-link factors over any path, and only recomputed when a door opens or closes.
+ *
+ * Paths: FindPath runs A* over the walkable links — open, open doors, stairs and entrances,
+ * never slabs or closed doors — and caches every answer until a door changes state.
+ * UEnemyAIManager asks GetNextHop every frame for each enemy chasing or investigating into
+ * another room, so that costs a lookup, not a search or a navmesh query.
+ */
+struct TWODSURVIVAL_API FBuildingRoomGraph
+{
+	int32 FloorCount = 0;
+	int32 RoomsPerFloor = 0;
+	TArray<FRoomLink> Links;
+
+	void Reset();
+
+	// Builds the per-node link lists FindPath walks. Call once Links is complete.
+	void BuildAdjacency();
+
+	int32 NumNodes() const { return FloorCount * RoomsPerFloor + 1; }
+	int32 GetOutsideNode() const { return FloorCount * RoomsPerFloor; }
+	int32 GetNode(int32 Floor, int32 Room) const { return Floor * RoomsPerFloor + Room; }
+
+	/**
+	 * Fraction (0–1) of a noise's loudness that reaches To from From.
+	 * Open links and stairs pass everything; a closed door passes ClosedDoorFactor and a floor
+	 * slab passes SlabFactor.
+	 */
+	float GetNoiseTransmission(int32 From, int32 To, float ClosedDoorFactor, float SlabFactor) const;
+
+	/**
+	 * Cheapest walkable route From → To, both ends included, into OutNodes.
+	 * False (OutNodes empty) if To can't be reached with the doors as they are now.
+	 */
+	bool FindPath(int32 From, int32 To, TArray<int32>& OutNodes, float* OutCost = nullptr) const;
+
+	/** Node after From on the cheapest route to To — From itself when already there, INDEX_NONE if unreachable. */
+	int32 GetNextHop(int32 From, int32 To) const;
+
+	/** The link between two nodes, or nullptr if they aren't adjacent. */
+	const FRoomLink* FindLink(int32 A, int32 B) const;
+
+private:
+	// CSR adjacency: node N's link indices are AdjacencyLinks[AdjacencyOffsets[N] .. AdjacencyOffsets[N + 1]).
+	TArray<int32> AdjacencyOffsets;
+	TArray<int32> AdjacencyLinks;
+
+	// Cheapest link of each kind — the A* heuristic's per-hop lower bounds.
+	float MinHorizontalCost = 0.f;
+	float MinVerticalCost = 0.f;
+	float MinEntranceCost = 0.f;
+
+	// Per link: false for slabs and closed doors. Bumps DoorStateVersion whenever a door changes.
+	mutable TArray<bool> LinkOpen;
+	mutable int32 DoorStateVersion = 0;
+
+	// NumNodes² matrix, valid for TransmissionVersion's door states and the cached factors.
+	mutable TArray<float> Transmission;
+	mutable int32 TransmissionVersion = INDEX_NONE;
+	mutable float CachedClosedDoorFactor = -1.f;
+	mutable float CachedSlabFactor = -1.f;
+
+	// FindPath results keyed by From * NumNodes + To, valid for PathCacheVersion's door states.
+	mutable TMap<int32, FRoomPath> PathCache;
+	mutable int32 PathCacheVersion = INDEX_NONE;
+
+	// Doors are few — comparing their state on every lookup is cheaper than having each door
+	// find and notify its building.
+	void RefreshDoorStates() const;
+
+	void RebuildTransmission(float ClosedDoorFactor, float SlabFactor) const;
+
+	// Admissible lower bound on the path cost From → To.
+	float EstimateCost(int32 From, int32 To) const;
+
+	FRoomPath SearchPath(int32 From, int32 To) const;
+	const FRoomPath& GetCachedPath(int32 From, int32 To) const;
+};
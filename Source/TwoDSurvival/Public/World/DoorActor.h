@@ -60,6 +60,11 @@ public:
 	virtual FText GetInteractionPrompt_Implementation() override;
 	virtual void OnInteract_Implementation(ABaseCharacter* Interactor) override;
 
+	bool IsOpen() const { return bIsOpen; }
+
+	// Opens/closes without sound or noise — used when restoring a street's saved state.
+	void SetOpen(bool bOpen);
+
 protected:
 	virtual void BeginPlay() override;
 
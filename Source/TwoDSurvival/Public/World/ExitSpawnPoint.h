@@ -33,7 +33,7 @@ public:
 
 	/**
 	 * Matches the ExitID on the FStreetExitLink that leads to this level.
-	 * UStreetManager scans all AExitSpawnPoints in the loaded level and teleports
+	 * UStreetManager indexes all AExitSpawnPoints in the loaded level by SpawnID and teleports
 	 * the player to the one whose SpawnID matches the incoming exit.
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawn")
@@ -60,6 +60,12 @@ public:
 	 */
 	bool IsInCone(FVector WorldPos) const;
 
+	/**
+	 * The cone IsInCone tests against — false if the light is off. Lets UEnemyAIManager
+	 * snapshot it once per frame and test it off the game thread.
+	 */
+	bool GetCone(FVector& OutOrigin, FVector& OutForward, float& OutCosHalfAngle) const;
+
 protected:
 	virtual void Tick(float DeltaTime) override;
 };
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GroundSpanCache.generated.h"
+
+class ULevel;
+class ABuildingGenerator;
+
+/** Ground under one X bin, as seen from one height band. */
+struct FGroundSample
+{
+	// Height of the highest static surface under the probe. Only meaningful when bHit.
+	float Z = 0.f;
+
+	// False over a gap — nothing static within ProbeDown of the band.
+	bool bHit = false;
+
+	// Inside an ABuildingGenerator's floors — doors, stairs and slabs need full character movement.
+	bool bInBuilding = false;
+};
+
+/**
+ * Ground height along X, traced once per BinWidth bin and HeightBand band and then reused by
+ * every enemy walking there — UEnemyMoverComponent's floor finding is a map lookup instead of
+ * a capsule sweep per enemy per frame.
+ *
+ * A bin is traced straight down against WorldStatic from ProbeUp above its band to ProbeDown
+ * below it, so a surface higher than a foot's step height shows up as an obstacle. Gameplay is
+ * in the X/Z plane, so bins are not keyed on Y.
+ *
+ * Samples are dropped whenever a level is added to or removed from the world (streets,
+ * building interiors) and when the world origin is rebased, since bins are keyed on world X.
+ * An ADoorActor opening or closing drops only the bins its panel covers (InvalidateRange).
+ *
+ * Tune in DefaultGame.ini under [/Script/TwoDSurvival.GroundSpanCache].
+ */
+UCLASS(Config = Game)
+class TWODSURVIVAL_API UGroundSpanCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Width (cm) of one sample along X.
+	UPROPERTY(Config, EditAnywhere, Category = "Ground", meta = (ClampMin = "1.0"))
+	float BinWidth = 50.f;
+
+	// Height (cm) of one band. Feet in the same band share a sample.
+	UPROPERTY(Config, EditAnywhere, Category = "Ground", meta = (ClampMin = "1.0"))
+	float HeightBand = 100.f;
+
+	// How far above the top of the band the probe starts — the tallest obstacle it can see.
+	UPROPERTY(Config, EditAnywhere, Category = "Ground", meta = (ClampMin = "0.0"))
+	float ProbeUp = 150.f;
+
+	// How far below the bottom of the band the probe looks for ground before calling it a gap.
+	UPROPERTY(Config, EditAnywhere, Category = "Ground", meta = (ClampMin = "0.0"))
+	float ProbeDown = 400.f;
+
+	/** Ground under X for a foot at FootZ, tracing the bin the first time it is asked for. */
+	FGroundSample Sample(float X, float Y, float FootZ);
+
+	/** Drops every sample. */
+	void Invalidate();
+
+	/** Drops the samples of every bin overlapping [MinX, MaxX], in all bands. */
+	void InvalidateRange(float MinX, float MaxX);
+
+	int32 GetBin(float X) const { return FMath::FloorToInt(X / BinWidth); }
+	float GetBinCenter(int32 Bin) const { return (Bin + 0.5f) * BinWidth; }
+
+	int32 NumSamples() const { return Samples.Num(); }
+
+private:
+	// Keyed by (X bin << 32) | height band.
+	TMap<int64, FGroundSample> Samples;
+
+	// Buildings in the world, gathered on the first sample after an invalidate.
+	TArray<TWeakObjectPtr<ABuildingGenerator>> Buildings;
+	bool bBuildingsDirty = true;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldOffsetHandle;
+
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin);
+
+	FGroundSample Trace(int32 Bin, int32 Band, float Y);
+};
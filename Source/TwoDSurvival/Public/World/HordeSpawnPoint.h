@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "HordeSpawnPoint.generated.h"
+
+class AEnemyBase;
+
+/**
+ * Place in a street sublevel (typically a highway segment) to stage a horde when it loads.
+ *
+ * On BeginPlay, adds Count UHordeManager members of EnemyClass spread over Spread cm of X
+ * around this point, at this point's Y/Z. Members are plain structs drawn with the class's
+ * HordeProxyMesh; only those near the player become real AEnemyBase actors.
+ *
+ * Like AWorldEventSpawnPoint, does nothing on a revisited street — the saved horde comes back instead.
+ */
+UCLASS()
+class TWODSURVIVAL_API AHordeSpawnPoint : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AHordeSpawnPoint();
+
+	/** Enemy Blueprint the horde is made of. Set its HordeProxyMesh to make the horde visible at range. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Horde")
+	TSubclassOf<AEnemyBase> EnemyClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Horde", meta = (ClampMin = "1"))
+	int32 Count = 200;
+
+	/** Width (cm) along X the horde is spread over, centred on this point. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Horde", meta = (ClampMin = "0.0"))
+	float Spread = 3000.f;
+
+protected:
+	virtual void BeginPlay() override;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY()
+	TObjectPtr<class UArrowComponent> EditorArrow;
+#endif
+};
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULevel;
+class AExitSpawnPoint;
+class AWorldEventSpawnPoint;
+class ABuildingEntrance;
+
+/**
+ * Lookup tables for the marker actors placed in one streamed street/building level.
+ *
+ * Built by UStreetManager in a single pass over Level->Actors the first time the level is
+ * shown, then kept until the level is unloaded. Replaces per-transition Level->Actors scans
+ * and the nightly GetAllActorsOfClass in AWorldEventManager.
+ */
+struct TWODSURVIVAL_API FLevelMarkerIndex
+{
+	// AExitSpawnPoint by SpawnID. First one wins if an ID is duplicated.
+	TMap<FName, TWeakObjectPtr<AExitSpawnPoint>> ExitSpawnPoints;
+
+	// Every AWorldEventSpawnPoint in the level, in actor order.
+	TArray<TWeakObjectPtr<AWorldEventSpawnPoint>> WorldEventSpawnPoints;
+
+	// AWorldEventSpawnPoint by SpawnPointID (points left at None are only in the array above).
+	TMap<FName, TWeakObjectPtr<AWorldEventSpawnPoint>> WorldEventSpawnPointsByID;
+
+	// Every ABuildingEntrance in the level, in actor order.
+	TArray<TWeakObjectPtr<ABuildingEntrance>> BuildingEntrances;
+
+	/** Single pass over Level->Actors. */
+	static FLevelMarkerIndex Build(const ULevel* Level);
+
+	AExitSpawnPoint* FindExitSpawnPoint(FName SpawnID) const;
+	AWorldEventSpawnPoint* FindWorldEventSpawnPoint(FName SpawnPointID) const;
+
+	/** First ABuildingEntrance still alive, or nullptr. */
+	ABuildingEntrance* GetFirstBuildingEntrance() const;
+};
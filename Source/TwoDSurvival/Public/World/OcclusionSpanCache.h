@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "OcclusionSpanCache.generated.h"
+
+class ULevel;
+class ADoorActor;
+
+/** A sight blocker as a rectangle in the X/Z gameplay plane. */
+struct FOcclusionSpan
+{
+	float MinX = 0.f;
+	float MaxX = 0.f;
+	float MinZ = 0.f;
+	float MaxZ = 0.f;
+
+	// False while the door it belongs to is open.
+	bool bBlocking = true;
+};
+
+/**
+ * Sight blockers of one world, bucketed into CellWidth cells along X with each cell's spans
+ * sorted by MinX. Plain data — UEnemyAIManager hands it to the decide pass, which may query it
+ * from worker threads. Only the game thread changes it, between updates.
+ */
+struct TWODSURVIVAL_API FOcclusionSpans
+{
+	/** Clears every span and sets the cell width. */
+	void Reset(float InCellWidth);
+
+	/** Adds a span over [MinX, MaxX] x [MinZ, MaxZ]. Call Finalize once all are added. Returns its index. */
+	int32 Add(float MinX, float MaxX, float MinZ, float MaxZ);
+
+	/** Sorts each cell by MinX. */
+	void Finalize();
+
+	void SetBlocking(int32 Index, bool bBlocking) { Spans[Index].bBlocking = bBlocking; }
+
+	/**
+	 * True if the segment From → To (projected onto X/Z) crosses no blocking span.
+	 * Touches only the cells the segment's X range covers.
+	 */
+	bool IsVisible(const FVector& From, const FVector& To) const;
+
+	int32 Num() const { return Spans.Num(); }
+
+private:
+	float CellWidth = 2000.f;
+	TArray<FOcclusionSpan> Spans;
+
+	// Span indices overlapping each cell, sorted by their MinX.
+	TMap<int32, TArray<int32>> Cells;
+
+	int32 GetCell(float X) const { return FMath::FloorToInt(X / CellWidth); }
+
+	static bool SegmentHitsSpan(const FVector2D& A, const FVector2D& B, const FOcclusionSpan& Span);
+};
+
+/**
+ * Line of sight without line traces. Builds FOcclusionSpans from what blocks sight in this
+ * game's geometry:
+ *   - ABuildingGenerator outer walls (every floor but an entrance ground floor),
+ *   - its floor slabs and roof, open where stairs or an elevator link two floors,
+ *   - every ADoorActor panel, blocking only while closed.
+ * Walls between rooms are either open or hold a door, so they need no span of their own.
+ *
+ * Rebuilt lazily after a level is added or removed, a building regenerates, a new door appears
+ * or the world origin is rebased. A door opening or closing only flips its own span
+ * (ADoorActor calls OnDoorChanged).
+ *
+ * Tune in DefaultGame.ini under [/Script/TwoDSurvival.OcclusionSpanCache].
+ */
+UCLASS(Config = Game)
+class TWODSURVIVAL_API UOcclusionSpanCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Width (cm) of one cell along X.
+	UPROPERTY(Config, EditAnywhere, Category = "Occlusion", meta = (ClampMin = "100.0"))
+	float CellWidth = 2000.f;
+
+	// Thickness (cm) of a building's outer walls.
+	UPROPERTY(Config, EditAnywhere, Category = "Occlusion", meta = (ClampMin = "1.0"))
+	float WallThickness = 20.f;
+
+	// Thickness (cm) of a building's floor slabs and roof.
+	UPROPERTY(Config, EditAnywhere, Category = "Occlusion", meta = (ClampMin = "1.0"))
+	float SlabThickness = 20.f;
+
+	/** The current spans, rebuilt first if anything invalidated them. Game thread only. */
+	const FOcclusionSpans& GetSpans();
+
+	/** Flips Door's span, or schedules a rebuild if Door is new. */
+	void OnDoorChanged(ADoorActor* Door);
+
+	/** Schedules a rebuild on the next GetSpans. */
+	void Invalidate() { bDirty = true; }
+
+private:
+	FOcclusionSpans Spans;
+	bool bDirty = true;
+
+	// Span index of each door.
+	TMap<TObjectKey<ADoorActor>, int32> DoorSpans;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldOffsetHandle;
+
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin);
+
+	void Rebuild();
+};
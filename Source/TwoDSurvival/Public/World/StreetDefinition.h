@@ -16,7 +16,7 @@ class UStreetDefinition;
  *
  *  AdjacentRight — loaded at CurrentOffset.X + CurrentStreet.StreetWidth  (walk-through, no teleport)
  *  AdjacentLeft  — loaded at CurrentOffset.X - NextStreet.StreetWidth      (walk-through, no teleport)
- *  Building      — loaded at BuildingWorldX (far off-grid); player is teleported to the
+ *  Building      — loaded BuildingWorldX past the street it is entered from (off-grid); player is teleported to the
  *                  AExitSpawnPoint inside the destination level whose SpawnID matches this ExitID.
  */
 UENUM(BlueprintType)
@@ -90,6 +90,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Street")
 	TSoftObjectPtr<UWorld> Level;
 
+	/**
+	 * Rough memory cost (MB) of keeping this sublevel loaded while hidden.
+	 * UStreetManager sums these against PrefetchMemoryBudgetMB (prefetch) and
+	 * CacheMemoryBudgetMB (recently left levels) when deciding what to keep resident.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Street", meta = (ClampMin = "0.0"))
+	float EstimatedMemoryMB = 64.f;
+
 	/**
 	 * All exits on this street. Add as many as needed.
 	 * Each entry's ExitID must match an AStreetExit::ExitID (or ABuildingEntrance::BuildingExitID)
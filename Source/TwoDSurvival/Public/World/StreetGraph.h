@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "World/StreetDefinition.h"
+#include "StreetGraph.generated.h"
+
+class UDefinitionCatalog;
+
+/** Cost used by FStreetGraph route queries. */
+UENUM(BlueprintType)
+enum class EStreetRouteMetric : uint8
+{
+	StreetCount UMETA(DisplayName = "Street Count"),  // fewest exits taken
+	Distance    UMETA(DisplayName = "Distance"),      // least summed StreetWidth walked
+};
+
+/** One resolved exit: FromStreet.Exits[...] → To (catalog street index). */
+struct FStreetGraphEdge
+{
+	int32       To     = INDEX_NONE;
+	FName       ExitID;
+	EExitLayout Layout = EExitLayout::AdjacentRight;
+};
+
+/**
+ * Shortest-path tree from one source street, as produced by FStreetGraph::GetRouteTree.
+ * Indexed by catalog street index. Unreached nodes have ParentEdge == INDEX_NONE and Cost < 0.
+ */
+struct FStreetRouteTree
+{
+	int32 Source = INDEX_NONE;
+	TArray<int32> ParentEdge;   // edge index (into FStreetGraph::Edges) used to reach each node
+	TArray<float> Cost;         // hops or summed width from Source
+
+	bool IsReached(int32 Node) const { return Cost.IsValidIndex(Node) && Cost[Node] >= 0.f; }
+};
+
+/**
+ * Resolved street connectivity (hard-wired + runtime-generated exits) in compressed-sparse-row
+ * form. Node IDs are UDefinitionCatalog street indices; node N's edges are
+ * Edges[EdgeOffsets[N] .. EdgeOffsets[N + 1]) in the same order as its Exits array.
+ *
+ * Rebuilt by UStreetManager whenever the city graph is generated or restored. Route trees are
+ * cached per (source, metric) until the next rebuild.
+ */
+struct TWODSURVIVAL_API FStreetGraph
+{
+	TArray<int32>            EdgeOffsets;  // NumNodes + 1
+	TArray<FStreetGraphEdge> Edges;
+	TArray<float>            NodeWidth;    // StreetWidth per node — edge cost for EStreetRouteMetric::Distance
+
+	/**
+	 * Resolves every exit of every catalog street: a hard-wired Destination wins, otherwise
+	 * Generated (StreetID → ExitID → ToStreetID) is consulted. Unresolvable exits are dropped.
+	 */
+	void Build(UDefinitionCatalog& Catalog, const TMap<FName, TMap<FName, FName>>& Generated);
+
+	void Reset();
+
+	int32 NumNodes() const { return FMath::Max(0, EdgeOffsets.Num() - 1); }
+	bool IsEmpty() const { return NumNodes() == 0; }
+
+	/** Edges leaving Node. Empty view for an invalid node. */
+	TConstArrayView<FStreetGraphEdge> GetEdges(int32 Node) const;
+
+	/** Index into Edges of Node's exit with this ID, or INDEX_NONE. */
+	int32 FindEdge(int32 Node, FName ExitID) const;
+
+	/**
+	 * Shortest-path tree from Source — BFS for StreetCount, Dijkstra for Distance. Cached.
+	 * The reference is only valid until the next GetRouteTree/FindRoute call.
+	 */
+	const FStreetRouteTree& GetRouteTree(int32 Source, EStreetRouteMetric Metric) const;
+
+	/**
+	 * Fills OutEdges with the edge indices to follow from From to To (empty when From == To).
+	 * Returns false if To is unreachable.
+	 */
+	bool FindRoute(int32 From, int32 To, EStreetRouteMetric Metric, TArray<int32>& OutEdges) const;
+
+private:
+	// Key = Source * 2 + Metric. Cleared when it grows past MaxCachedTrees.
+	mutable TMap<int32, FStreetRouteTree> RouteTreeCache;
+
+	static constexpr int32 MaxCachedTrees = 32;
+};
@@ -5,10 +5,17 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "World/StreetDefinition.h"
+#include "World/LevelMarkerIndex.h"
+#include "World/StreetGraph.h"
+#include "World/StreetTransitionTimeline.h"
+#include "World/StreetStateStore.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/TimerHandle.h"
 #include "StreetManager.generated.h"
 
 class ULevelStreamingDynamic;
 class UTwoDSurvivalSaveGame;
+class UDefinitionCatalog;
 
 // Fired when the active street/building changes — UStreetHUDWidget binds this to refresh arrows.
 DECLARE_MULTICAST_DELEGATE(FOnStreetChanged);
@@ -16,6 +23,54 @@ DECLARE_MULTICAST_DELEGATE(FOnStreetChanged);
 // Fired when the player moves into a different city (or onto a highway / back into a city).
 DECLARE_MULTICAST_DELEGATE(FOnCityChanged);
 
+/**
+ * A street or building sublevel that is loaded but not the active one.
+ * Prefetched neighbours and recently left levels (LRU cache) sit here hidden
+ * until the player crosses back into them.
+ */
+USTRUCT()
+struct FResidentStreetLevel
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UStreetDefinition> Street;
+
+	// City-space offset the level was loaded at — a street can only be reused at the same placement.
+	UPROPERTY()
+	FVector Offset = FVector::ZeroVector;
+
+	UPROPERTY()
+	TObjectPtr<ULevelStreamingDynamic> Streaming;
+
+	// True while this level is part of the current prefetch set — pinned, never evicted by the LRU.
+	bool bPrefetched = false;
+
+	// Requested visibility. Only walk-through neighbours in the seamless window are shown.
+	bool bVisible = false;
+
+	// UStreetManager::ResidentUseCounter value when this level was last active — lowest is evicted first.
+	uint64 LastUsed = 0;
+};
+
+/**
+ * One street transition. UStreetManager::TransitionQueue holds them in order; the first is in
+ * flight while a transition is in progress. Resolved against the street it leaves from.
+ */
+struct FStreetTransitionStep
+{
+	TObjectPtr<UStreetDefinition> From;
+	FVector FromOffset = FVector::ZeroVector;
+
+	TObjectPtr<UStreetDefinition> To;
+	FVector ToOffset = FVector::ZeroVector;
+
+	// Exit taken on From. None when leaving a building interior.
+	FName ExitID = NAME_None;
+	EExitLayout Layout = EExitLayout::AdjacentRight;
+	bool bExitBuilding = false;
+};
+
 /**
  * Lives on the GameInstance — persists for the lifetime of the game session.
  *
@@ -29,25 +84,59 @@ DECLARE_MULTICAST_DELEGATE(FOnCityChanged);
  *   player walks across naturally — no teleport.
  * Building exits: destination is loaded at a far-off X (BuildingWorldX); player is teleported
  *   to an AExitSpawnPoint whose SpawnID matches the ExitID used to enter.
+ *
+ * Prefetch: whenever a street becomes current, the streets behind its walk-through exits
+ * (up to PrefetchDepth hops, within PrefetchMemoryBudgetMB) are loaded hidden. Crossing into
+ * one of them only flips it visible instead of waiting on a cold load.
+ *
+ * Resident cache: the level the player just left (street or building interior) is kept
+ * hidden instead of unloaded, so popping in and out of a shop is a visibility flip rather
+ * than two full streaming cycles. Non-prefetched resident levels are evicted least recently
+ * used first, bounded by MaxCachedLevels and CacheMemoryBudgetMB.
+ *
+ * Seamless window (bSeamlessStreetWindow): the walk-through neighbours of the current street
+ * are kept visible at their ComputeAdjacentOffset positions, and the current street follows the
+ * player's X instead of AStreetExit triggers — crossing never waits on a load. Neighbours two
+ * hops away stay shown until the player moves on, so pacing across one boundary flips nothing.
+ * Off by default — opt in per project or map config; with it off, AStreetExit triggers drive
+ * every transition as before.
+ *
+ * Offsets are city-space: once the current street is WorldRebaseDistance from the world
+ * origin the origin is moved onto it, so world X stays small on long highway trips.
+ *
+ * Transition queue: exits crossed while a transition is loading are queued rather than dropped
+ * and started in order, so OnStreetChanged fires once per transition, strictly in sequence.
+ * Queued destinations start loading hidden right away (pipelining). Crossing back toward the
+ * street a pending transition came from cancels it instead of queueing a second load.
+ *
+ * Street state: every level comes back pristine when reshown, so the enemies, pickups,
+ * opened doors and broken props of the street being left are captured into FStreetStateStore
+ * and re-materialized the next time that street is shown (TwoD.StreetStateStats).
+ *
+ * Tune in DefaultGame.ini under [/Script/TwoDSurvival.StreetManager].
  */
-UCLASS()
+UCLASS(Config = Game)
 class TWODSURVIVAL_API UStreetManager : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	// Declares the UDefinitionCatalog dependency so its async scan starts first.
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
 	/** Called by AStreetBootstrapper in BeginPlay to load the initial street. */
 	void InitializeWithStreet(UStreetDefinition* StartStreet, FVector WorldOffset = FVector::ZeroVector);
 
 	/**
 	 * Called by AStreetExit (walk-through) or ABuildingEntrance (press-E, street side).
-	 * ExitID must match a FStreetExitLink::ExitID on CurrentStreet.
+	 * ExitID must match a FStreetExitLink::ExitID on the street SourceLevel belongs to — the
+	 * current one or the pending one. Without a SourceLevel it applies after any queued transitions.
 	 */
-	void OnPlayerCrossedExit(FName ExitID);
+	void OnPlayerCrossedExit(FName ExitID, const ULevel* SourceLevel = nullptr);
 
 	/**
 	 * Called by ABuildingEntrance (press-E, building side).
-	 * Exits the current building and restores the street the player came from.
+	 * Exits the building (after any queued transitions) and restores the street the player came from.
 	 */
 	void OnPlayerExitBuilding();
 
@@ -86,12 +175,47 @@ public:
 	/** Looks up a UStreetDefinition by its StreetID (from the scanned asset map). */
 	UStreetDefinition* FindStreetByID(FName StreetID) const;
 
-	/** Serialize the current runtime graph into a save game object. */
+	/** Resolved connectivity of every catalog street (node = UDefinitionCatalog street index). */
+	const FStreetGraph& GetStreetGraph() const { return StreetGraph; }
+
+	/** Catalog index of Street — the node ID in GetStreetGraph(). INDEX_NONE if unknown. */
+	int32 GetStreetIndex(const UStreetDefinition* Street) const;
+
+	/** Catalog street for a graph node index, or null. */
+	UStreetDefinition* GetStreetByIndex(int32 Index) const;
+
+	/**
+	 * Shortest route From → To. OutStreets lists the streets entered in order (To last),
+	 * OutExitIDs the exit taken to enter each one. Returns false if unreachable.
+	 * Source trees are cached until the graph is rebuilt — cheap to call every frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Map")
+	bool FindRoute(UStreetDefinition* From, UStreetDefinition* To, EStreetRouteMetric Metric,
+		TArray<UStreetDefinition*>& OutStreets, TArray<FName>& OutExitIDs) const;
+
+	/** Store the graph's seed and generator version in a save game object (no edges). */
 	void SaveGraphToSaveGame(UTwoDSurvivalSaveGame* Save) const;
 
-	/** Restore the runtime graph from a save game object (skips generation). */
+	/** Rebuild the runtime graph from the saved seed (or legacy saved edges). */
 	void RestoreGraphFromSaveGame(const UTwoDSurvivalSaveGame* Save);
 
+	/**
+	 * Bump whenever BuildCityGraph's output for a given seed changes (RNG call order,
+	 * pairing rules, ...). Saves with a different version still load but get a new layout.
+	 */
+	static constexpr int32 CityGraphVersion = 1;
+
+	/** Seed the current city graph was generated from. */
+	int32 GetWorldSeed() const { return WorldSeed; }
+
+	/**
+	 * Deterministic city graph generation: the same Streets (in the same order) and Seed
+	 * always produce the same OutGraph. Streets is normally UDefinitionCatalog::GetStreets().
+	 * Static so the TwoD.BenchCityGraph console command can run it on a synthetic catalog.
+	 */
+	static void BuildCityGraph(TConstArrayView<TObjectPtr<UStreetDefinition>> Streets, int32 Seed,
+		TMap<FName, TMap<FName, FName>>& OutGraph);
+
 	/** The street the session started on (used as BFS root for map layout). */
 	UFUNCTION(BlueprintCallable, Category = "Map")
 	UStreetDefinition* GetStartingStreet() const { return StartingStreetDef; }
@@ -100,7 +224,7 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Street")
 	TObjectPtr<UStreetDefinition> CurrentStreet;
 
-	/** World-space origin of the currently active sublevel. */
+	/** City-space origin of the currently active sublevel (world space + world origin). */
 	UPROPERTY(BlueprintReadOnly, Category = "Street")
 	FVector CurrentStreetWorldOffset = FVector::ZeroVector;
 
@@ -108,6 +232,81 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Building")
 	bool bIsInsideBuilding = false;
 
+	// ── Prefetch config ───────────────────────────────────────────────────────
+
+	/**
+	 * How many walk-through hops from the current street to keep loaded in the background.
+	 * 0 disables prefetching — every crossing waits on a cold load.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0"))
+	int32 PrefetchDepth = 1;
+
+	/** Cap on the summed UStreetDefinition::EstimatedMemoryMB of all prefetched (hidden) levels. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float PrefetchMemoryBudgetMB = 256.f;
+
+	/** Max recently-left levels (streets + interiors) kept loaded but hidden. 0 disables the cache. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0"))
+	int32 MaxCachedLevels = 4;
+
+	/** Cap on the summed UStreetDefinition::EstimatedMemoryMB of cached (non-prefetched) levels. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float CacheMemoryBudgetMB = 512.f;
+
+	// ── Seamless window config ────────────────────────────────────────────────
+
+	/** Keep both walk-through neighbours visible and switch streets by player position. Opt-in. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming")
+	bool bSeamlessStreetWindow = false;
+
+	/** How far (cm) past a street edge the player must walk before the neighbour becomes current. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float WindowSwitchMargin = 150.f;
+
+	/** Seconds between player-position checks while the seamless window is active. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.01"))
+	float WindowCheckInterval = 0.1f;
+
+	/** Rebase the world origin onto the current street once it is this far (cm) away. 0 disables. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float WorldRebaseDistance = 500000.f;
+
+	/** Transitions (in flight + waiting) the queue holds before further exits are dropped. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Streaming", meta = (ClampMin = "1"))
+	int32 MaxQueuedTransitions = 4;
+
+	/** Transitions that reused a resident level (prefetched or cached) instead of loading from disk. */
+	UFUNCTION(BlueprintPure, Category = "Streaming")
+	int32 GetResidentCacheHits() const { return ResidentCacheHits; }
+
+	/** Transitions that had to start a cold level load. */
+	UFUNCTION(BlueprintPure, Category = "Streaming")
+	int32 GetResidentCacheMisses() const { return ResidentCacheMisses; }
+
+	/** Per-phase timings of recent street transitions (TwoD.StreetTransitionStats). */
+	FStreetTransitionTimeline& GetTransitionTimeline() { return TransitionTimeline; }
+
+	/**
+	 * Marker index (exit spawn points, world-event spawn points, building entrances) for the
+	 * currently shown street or interior. Null before the first street is shown.
+	 */
+	const FLevelMarkerIndex* GetActiveMarkers() const;
+
+	/**
+	 * True while Level is being shown for a street that already has a saved state record.
+	 * AWorldEventSpawnPoint checks this in BeginPlay so restored enemies aren't rolled twice.
+	 */
+	bool ShouldSuppressLevelSpawns(const ULevel* Level) const;
+
+	/**
+	 * True if Level belongs to a loaded street that is not the current one (a visible window
+	 * neighbour). OnPlayerCrossedExit ignores triggers in these — their exit IDs aren't the current street's.
+	 */
+	bool IsInactiveStreetLevel(const ULevel* Level) const;
+
+	/** Saved state of every street left this session. */
+	const FStreetStateStore& GetStreetStates() const { return StreetStates; }
+
 private:
 	// Building sublevels are placed at this fixed X offset, clear of the street grid.
 	static constexpr float BuildingWorldX = 100000.f;
@@ -128,12 +327,64 @@ private:
 	UPROPERTY()
 	TObjectPtr<ULevelStreamingDynamic> StreamingToUnload;
 
+	// Street + offset of StreamingToUnload — lets the outgoing level be kept as a prefetched neighbour.
+	TObjectPtr<UStreetDefinition> StreetToUnload;
+	FVector StreetToUnloadOffset = FVector::ZeroVector;
+
 	bool bTransitionInProgress = false;
 
+	// True from commit to the end of OnNewStreetShown — queued steps wait for the broadcast.
+	bool bCommittingTransition = false;
+
+	// ── Transition queue ──────────────────────────────────────────────────────
+	// TransitionQueue[0] is in flight while bTransitionInProgress. The chain is CurrentStreet
+	// followed by each step's destination; chain index i + 1 is TransitionQueue[i].To.
+	TArray<FStreetTransitionStep> TransitionQueue;
+
+	int32 TransitionChainLength() const;
+	UStreetDefinition* GetTransitionChainStreet(int32 Index) const;
+	FVector GetTransitionChainOffset(int32 Index) const;
+	bool IsTransitionChainInterior(int32 Index) const;
+
+	// Declared layout of ExitID on Street, or inferred from the "Left"/"Right" naming convention.
+	static EExitLayout GetExitLayout(const UStreetDefinition* Street, FName ExitID);
+
+	// Resolves the step leaving chain position FromIndex. False if the exit is blocked.
+	bool ResolveTransitionStep(int32 FromIndex, FName ExitID, bool bExitBuilding, FStreetTransitionStep& OutStep) const;
+
+	// Coalesces, cancels or queues a transition leaving From, and starts it if nothing is in flight.
+	void RequestTransition(UStreetDefinition* From, FName ExitID, bool bExitBuilding);
+
+	// Drops every step after the first KeepSteps, cancelling the in-flight one if KeepSteps is 0.
+	void TruncateTransitionQueue(int32 KeepSteps);
+
+	// Sets up pending state for Step and loads its destination.
+	void StartTransitionStep(const FStreetTransitionStep& Step);
+
+	// Hands the in-flight pending level back to the resident cache (hidden) and clears pending state.
+	void CancelInFlightTransition();
+
+	// A load failed — clears pending state and the rest of the queue.
+	void AbortTransition();
+
+	// True if a queued step leads to Street at Offset — keeps its pipelined load pinned.
+	bool IsQueuedDestination(const UStreetDefinition* Street, const FVector& Offset) const;
+
+	// ── Prefetch + resident cache ─────────────────────────────────────────────
+	// Loaded-but-hidden levels. Never contains ActiveStreaming or PendingStreaming.
+	UPROPERTY()
+	TArray<FResidentStreetLevel> ResidentLevels;
+
+	// Monotonic stamp for FResidentStreetLevel::LastUsed.
+	uint64 ResidentUseCounter = 0;
+
+	int32 ResidentCacheHits   = 0;
+	int32 ResidentCacheMisses = 0;
+
 	// ── Building return state ──────────────────────────────────────────────────
 	TObjectPtr<UStreetDefinition> ReturnStreet;
 	FVector ReturnStreetOffset   = FVector::ZeroVector;
-	FVector ReturnPlayerLocation = FVector::ZeroVector;
+	FVector ReturnPlayerLocation = FVector::ZeroVector;  // city space — survives an origin rebase
 
 	// The ExitID used to enter the building — matched against AExitSpawnPoint::SpawnID on load.
 	FName PendingIncomingExitID = NAME_None;
@@ -143,34 +394,95 @@ private:
 	ETransitionType PendingTransitionType = ETransitionType::Street;
 
 	// ── Runtime city graph ─────────────────────────────────────────────────────
-	// Generated once per new game, then saved/restored. Maps StreetID → (ExitID → ToStreetID).
+	// Generated once per new game from WorldSeed; saves store only the seed.
+	// Maps StreetID → (ExitID → ToStreetID).
 	TMap<FName, TMap<FName, FName>> GeneratedGraph;
 
-	// All scanned UStreetDefinition assets, keyed by StreetID.
-	UPROPERTY()
-	TMap<FName, TObjectPtr<UStreetDefinition>> AllStreetDefsMap;
+	int32 WorldSeed = 0;
+
+	// GeneratedGraph + hard-wired exits, resolved to catalog indices. Rebuilt with GeneratedGraph.
+	FStreetGraph StreetGraph;
+
+	void RebuildStreetGraph();
 
 	bool bCityGenerated = false;
 
-	/** Scan all UStreetDefinition assets into AllStreetDefsMap via AssetRegistry. */
-	void ScanAllStreetDefs();
+	// Street/city definitions live in UDefinitionCatalog (StreetID → def, dense index).
+	UDefinitionCatalog* GetCatalog() const;
 
 	/**
-	 * Scan all city street defs via AssetRegistry, shuffle each city's pool,
+	 * Take all city street defs from UDefinitionCatalog, shuffle each city's pool,
 	 * pick MinStreets–MaxStreets streets per city, and wire Left/Right connections.
-	 * Called once on first game start (no saved graph).
+	 * Called on first game start with a fresh seed, and on load with the saved one.
 	 */
-	void GenerateCityGraph();
+	void GenerateCityGraph(int32 Seed);
 
 	// ── Internal helpers ───────────────────────────────────────────────────────
+	// Makes Street the pending level — reuses a resident (prefetched) instance if one matches.
 	void LoadStreet(UStreetDefinition* Street, FVector WorldOffset);
 
 	// Bound to ULevelStreamingDynamic::OnLevelShown — fires once per load.
 	UFUNCTION()
 	void OnNewStreetShown();
 
-	// Computes where to place an adjacent Left/Right street in world space.
-	FVector ComputeAdjacentOffset(EExitLayout Layout, UStreetDefinition* AdjacentStreet) const;
+	// Bound to ULevelStreamingDynamic::OnLevelLoaded on cold loads — closes the Load (I/O) phase.
+	UFUNCTION()
+	void OnPendingLevelLoaded();
+
+	// ── Seamless window ───────────────────────────────────────────────────────
+	FTimerHandle WindowCheckTimer;
+
+	// Timer callback — crosses into the neighbour once the player is WindowSwitchMargin past an edge.
+	void CheckWindowCrossing();
+
+	// Bound to OnLevelShown of window neighbours — restores their street state once visible.
+	UFUNCTION()
+	void OnResidentLevelShown();
+
+	// Makes a resident level visible or hidden, capturing / restoring its street state.
+	void SetResidentVisible(FResidentStreetLevel& Resident, bool bVisible);
+
+	// Moves the world origin onto the current street when it has drifted WorldRebaseDistance away.
+	void RebaseWorldOriginIfNeeded();
+
+	// World origin in city space (UWorld::OriginLocation). World = city - origin.
+	FVector GetWorldOrigin() const;
+
+	// ── Instrumentation ───────────────────────────────────────────────────────
+	FStreetTransitionTimeline TransitionTimeline;
+
+	// Computes where to place an adjacent Left/Right street in world space, relative to FromStreet.
+	static FVector ComputeAdjacentOffset(UStreetDefinition* FromStreet, const FVector& FromOffset,
+		EExitLayout Layout, UStreetDefinition* AdjacentStreet);
+
+	// Starts a LoadLevelInstance for Street at WorldOffset. Returns null on failure.
+	ULevelStreamingDynamic* StartLevelLoad(UStreetDefinition* Street, FVector WorldOffset, bool bVisible);
+
+	// Requests unload of a streaming level (hidden + not loaded) and drops its marker index.
+	void UnloadLevel(ULevelStreamingDynamic* Streaming);
+
+	// ── Marker index ──────────────────────────────────────────────────────────
+	// One FLevelMarkerIndex per loaded street/interior level, built on first show.
+	TMap<TObjectKey<ULevel>, FLevelMarkerIndex> LevelMarkers;
+
+	// Returns the index for Level, building it on first use.
+	const FLevelMarkerIndex& GetOrBuildMarkers(ULevel* Level);
+
+	// ── Street state ──────────────────────────────────────────────────────────
+	// Keyed by StreetID; each street owns the X span [Offset.X, Offset.X + StreetWidth).
+	FStreetStateStore StreetStates;
+
+	// Returns the index into ResidentLevels matching Street at Offset, or INDEX_NONE.
+	int32 FindResidentLevel(const UStreetDefinition* Street, const FVector& Offset) const;
+
+	/**
+	 * Walks the current street's walk-through exits up to PrefetchDepth hops, loads any
+	 * missing neighbours hidden and hands resident levels that are no longer wanted to the LRU cache.
+	 */
+	void UpdatePrefetch();
+
+	// Unloads least-recently-used non-prefetched levels until the cache fits its count and memory caps.
+	void TrimResidentCache();
 
 	/**
 	 * Scans Level for an AExitSpawnPoint whose SpawnID matches IncomingExitID and teleports the player there.
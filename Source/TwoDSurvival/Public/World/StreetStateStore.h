@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Enemy/EnemyTypes.h"
+#include "UObject/SoftObjectPath.h"
+
+class UWorld;
+class AWorldProp;
+class UDefinitionCatalog;
+
+// ── Saved records ─────────────────────────────────────────────────────────────
+// Plain data only — positions are relative to the street's origin, since the same street
+// can be placed at a different X depending on which side it was entered from.
+
+/** One live enemy on a street that was left. 24 bytes. */
+struct FSavedEnemyState
+{
+	FVector3f LocalPosition = FVector3f::ZeroVector;
+	float Yaw = 0.f;
+	float BodyHealth = 0.f;
+
+	// Index into FStreetStateStore::EnemyClasses.
+	uint16 ClassIndex = 0;
+	EEnemyState State = EEnemyState::Idle;
+};
+
+/** One UHordeManager member on a street that was left. 28 bytes. */
+struct FSavedHordeMember
+{
+	FVector3f LocalPosition = FVector3f::ZeroVector;
+	float LocalHomeX = 0.f;
+	float LocalAlertX = 0.f;
+	float BodyHealth = 0.f;
+
+	// Index into FStreetStateStore::EnemyClasses.
+	uint16 ClassIndex = 0;
+	EEnemyState State = EEnemyState::Idle;
+	int8 Dir = 1;
+};
+
+/** One AWorldItem pickup lying on a street that was left. 20 bytes. */
+struct FSavedItemState
+{
+	FVector3f LocalPosition = FVector3f::ZeroVector;
+
+	// UDefinitionCatalog item index.
+	int32 ItemIndex = INDEX_NONE;
+	int32 Quantity = 1;
+};
+
+enum class ESavedPropFlags : uint8
+{
+	None      = 0,
+	DoorOpen  = 1 << 0,
+	Broken    = 1 << 1,
+	Destroyed = 1 << 2,
+};
+ENUM_CLASS_FLAGS(ESavedPropFlags);
+
+/**
+ * A door or breakable prop whose state differs from a fresh level. Props are matched back
+ * to actors by their street-local position snapped to a 10 cm grid — placed actors and
+ * doors from a seeded ABuildingGenerator land on the same cell every time the street loads.
+ */
+struct FSavedPropState
+{
+	FIntVector Cell = FIntVector::ZeroValue;
+	ESavedPropFlags Flags = ESavedPropFlags::None;
+};
+
+/** Everything remembered about one street between visits. */
+struct FStreetStateRecord
+{
+	TArray<FSavedEnemyState> Enemies;
+	TArray<FSavedHordeMember> Horde;
+	TArray<FSavedItemState> Items;
+	TArray<FSavedPropState> Props;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Enemies.GetAllocatedSize() + Horde.GetAllocatedSize() + Items.GetAllocatedSize()
+			+ Props.GetAllocatedSize();
+	}
+};
+
+// ── Store ─────────────────────────────────────────────────────────────────────
+
+/**
+ * Compact state of every street the player has left this session, owned by UStreetManager.
+ *
+ * Enemies and dropped items are spawned into the persistent level, and a streamed level
+ * comes back pristine (every BeginPlay runs again) whenever it is reshown or reloaded.
+ * Capture() turns the dynamic actors inside a street's X span into POD records and destroys
+ * them (UHordeManager members in the span are taken too); Restore() spawns them back and
+ * reapplies door/breakable flags when the street is shown again. A street with a record is authoritative — its AWorldEventSpawnPoints don't roll.
+ * Several streets can be live (shown) at once; Capture/Restore are no-ops on a street that is
+ * already captured/live, so callers may invoke them on every visibility change.
+ *
+ * A typical street (a dozen enemies, a few pickups and doors) is well under 1 KB, so
+ * hundreds of streets fit in a few hundred KB — far below keeping their levels resident.
+ */
+struct TWODSURVIVAL_API FStreetStateStore
+{
+	/**
+	 * Records and destroys the enemies and AWorldItems with X in [Origin.X, Origin.X + Width),
+	 * plus opened doors and broken (or since-destroyed) breakables. Replaces any previous record.
+	 */
+	void Capture(UWorld* World, FName StreetID, const FVector& Origin, float Width, UDefinitionCatalog& Catalog);
+
+	/**
+	 * Re-materializes StreetID's record over the same span (origin may differ from capture).
+	 * Without a record it only starts tracking the span's breakables for the next Capture.
+	 */
+	void Restore(UWorld* World, FName StreetID, const FVector& Origin, float Width, UDefinitionCatalog& Catalog);
+
+	bool Contains(FName StreetID) const { return Records.Contains(StreetID); }
+
+	/** True between Restore() and Capture() — the street's actors are in the world. */
+	bool IsLive(FName StreetID) const { return LiveStreets.Contains(StreetID); }
+
+	void Reset();
+
+	int32 Num() const { return Records.Num(); }
+
+	/** Heap bytes held by all records, the class table and the record map. */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Writes record/entity counts and memory use to Ar. */
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	TMap<FName, FStreetStateRecord> Records;
+
+	// Enemy classes by FSavedEnemyState::ClassIndex. Soft paths — a record must not keep
+	// a Blueprint class loaded once its street is gone.
+	TArray<FSoftClassPath> EnemyClasses;
+
+	// Streets restored and not yet captured.
+	TSet<FName> LiveStreets;
+
+	// Breakables of each live street, gathered by Restore(). One that is gone by the
+	// matching Capture() was destroyed; a null entry was already destroyed on restore.
+	TMap<FName, TArray<TPair<TWeakObjectPtr<AWorldProp>, FIntVector>>> TrackedBreakables;
+
+	// Index of Class in EnemyClasses, adding it on first use.
+	uint16 FindOrAddEnemyClass(const UClass* Class);
+
+	static FIntVector MakePropCell(const FVector& LocalPosition);
+};
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+// Insights channel for street transitions — enable with -trace=default,StreetTransition.
+UE_TRACE_CHANNEL_EXTERN(StreetTransitionChannel, TWODSURVIVAL_API);
+
+/**
+ * Phases of one UStreetManager street change, in order.
+ *
+ *  Request   — exit crossed / door used → level load issued (or resident level made visible)
+ *  Load      — async package load (I/O); zero for resident levels
+ *  Show      — AddToWorld, including every actor's BeginPlay (e.g. ABuildingGenerator::Generate)
+ *  Teleport  — commit new street, index markers, move the player
+ *  Prefetch  — UpdatePrefetch / resident cache trim
+ *  Broadcast — OnStreetChanged listeners
+ */
+enum class EStreetTransitionPhase : uint8
+{
+	Request,
+	Load,
+	Show,
+	Teleport,
+	Prefetch,
+	Broadcast,
+	Count
+};
+
+/** Timings for one completed transition. */
+struct FStreetTransitionRecord
+{
+	FName StreetID;
+	bool  bResident = false;   // destination was already loaded (prefetched or cached)
+	float PhaseMs[static_cast<int32>(EStreetTransitionPhase::Count)] = {};
+	float TotalMs = 0.f;
+};
+
+/**
+ * Records per-phase wall-clock timings of street transitions into a fixed-size ring buffer
+ * and mirrors each phase as an Insights timing region on StreetTransitionChannel.
+ *
+ * Owned by UStreetManager. Inspect with the TwoD.StreetTransitionStats console command.
+ */
+class TWODSURVIVAL_API FStreetTransitionTimeline
+{
+public:
+	/** Starts timing a transition to StreetID. Any unfinished transition is discarded. */
+	void Begin(FName StreetID);
+
+	/**
+	 * Closes Phase at the current time (time since the previous mark) and opens the next one.
+	 * Mark every phase in order — a skipped phase just gets a zero-length mark.
+	 */
+	void MarkPhaseEnd(EStreetTransitionPhase Phase);
+
+	void SetResident(bool bResident) { Current.bResident = bResident; }
+
+	/** Finishes the transition and pushes it into the ring buffer. */
+	void End();
+
+	/** Drops the in-flight transition (load failed). */
+	void Cancel();
+
+	bool IsActive() const { return bActive; }
+
+	/** Logs p50/p95/max per phase per street ID. Filter = NAME_None for every street. */
+	void DumpStats(FOutputDevice& Ar, FName Filter = NAME_None) const;
+
+	void Reset();
+
+	static const TCHAR* GetPhaseName(EStreetTransitionPhase Phase);
+
+private:
+	static constexpr int32 Capacity = 256;
+
+	TArray<FStreetTransitionRecord> Ring;
+	int32 NextSlot = 0;
+
+	FStreetTransitionRecord Current;
+	double StartTime    = 0.0;
+	double LastMarkTime = 0.0;
+	int32  OpenRegion   = INDEX_NONE;   // phase whose Insights region is open, if tracing
+	bool   bActive      = false;
+
+	void BeginPhaseRegion(int32 Phase);
+	void EndPhaseRegion();
+};
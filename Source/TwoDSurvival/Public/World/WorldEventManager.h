@@ -182,7 +182,7 @@ private:
 	UPROPERTY()
 	TObjectPtr<ANPCActor> ActiveTrader;
 
-	// All AWorldEventSpawnPoint actors found in the level at BeginPlay.
+	// AWorldEventSpawnPoint actors in the current street, refreshed from UStreetManager's marker index each roll.
 	UPROPERTY()
 	TArray<TObjectPtr<AWorldEventSpawnPoint>> SpawnPoints;
 